@@ -439,18 +439,15 @@ static resultCode_t S__readResult()
             {
                 PRINTF(dbgColor__white, "%s:dataMode>\r", g_lqLTEM.atcmd->streamPrefix);                // entered stream data mode
                 resultCode_t dataRslt = (*g_lqLTEM.atcmd->dataMode.dataHndlr)();
-                if (dataRslt == resultCode__success)
+                if (dataRslt != resultCode__success)
                 {
-                    if (dataRslt != resultCode__success)
-                    {
-                        g_lqLTEM.atcmd->parserResult = cmdParseRslt_error;
-                        g_lqLTEM.atcmd->resultCode = dataRslt;
-                    }
-                    else if (g_lqLTEM.atcmd->dataMode.skipParser)
-                    {
-                        g_lqLTEM.atcmd->parserResult = cmdParseRslt_success;
-                        g_lqLTEM.atcmd->resultCode = dataRslt;
-                    }
+                    g_lqLTEM.atcmd->parserResult = cmdParseRslt_error;
+                    g_lqLTEM.atcmd->resultCode = dataRslt;
+                }
+                else if (g_lqLTEM.atcmd->dataMode.skipParser)
+                {
+                    g_lqLTEM.atcmd->parserResult = cmdParseRslt_success;
+                    g_lqLTEM.atcmd->resultCode = dataRslt;
                 }
                 PRINTF(dbgColor__white, "Exit dataMode rslt=%d\r", dataRslt);
                 memset(&g_lqLTEM.atcmd->dataMode, 0, sizeof(dataMode_t));                               // done with dataMode settings
@@ -0,0 +1,416 @@
+/** ****************************************************************************
+  \file 
+  \brief Public API providing host name resolution (DNS) cache
+  \author Greg Terrell, LooUQ Incorporated
+
+  \loouq
+
+--------------------------------------------------------------------------------
+
+    This project is released under the GPL-3.0 License.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ 
+***************************************************************************** */
+
+
+#define _DEBUG 0                        // set to non-zero value for PRINTF debugging output, 
+// debugging output options             // LTEm1c will satisfy PRINTF references with empty definition if not already resolved
+#if _DEBUG > 0
+    asm(".global _printf_float");       // forces build to link in float support for printf
+    #if _DEBUG == 1
+    #define SERIAL_DBG 1                // enable serial port output using devl host platform serial, 1=wait for port
+    #elif _DEBUG == 2
+    #include <jlinkRtt.h>               // output debug PRINTF macros to J-Link RTT channel
+    #define PRINTF(c_,f_,__VA_ARGS__...) do { rtt_printf(c_, (f_), ## __VA_ARGS__); } while(0)
+    #endif
+#else
+#define PRINTF(c_, f_, ...)
+#endif
+
+#define SRCFILE "DNS"                           // create SRCFILE (3 char) MACRO for lq-diagnostics ASSERT
+#include "ltemc-internal.h"
+#include "ltemc-dns.h"
+
+extern ltemDevice_t g_lqLTEM;
+
+
+#define MIN(x, y) (((x) < (y)) ? (x) : (y))
+#define DNS_URC_SZ 80
+
+// file scope local function declarations
+static const char* S__dnsResolveHost(const char *hostName);
+static void S__dnsDoWork();
+static void S__dnsParseUrc();
+static void S__dnsParseUrcLine(const char *urcLine);
+static bool S__dnsStartQuery(uint8_t entryIndx);
+static int8_t S__dnsFindEntry(const char *hostName);
+static uint8_t S__dnsReplaceEntry();
+static bool S__isIpAddress(const char *hostName);
+
+
+
+#pragma region public DNS cache functions
+/* --------------------------------------------------------------------------------------------- */
+
+
+/**
+ *	@brief Create the DNS cache and enable its use for socket/MQTT/HTTP opens.
+ */
+void dns_create(uint8_t pdpCntxt)
+{
+    if (g_lqLTEM.dnsCache == NULL)
+    {
+        g_lqLTEM.dnsCache = calloc(1, sizeof(dnsCache_t));
+        ASSERT(g_lqLTEM.dnsCache != NULL);
+    }
+    g_lqLTEM.dnsCache->pdpCntxt = pdpCntxt;
+    g_lqLTEM.dnsCache->queryIndx = -1;
+    g_lqLTEM.dnsResolver = S__dnsResolveHost;
+
+    LTEM_registerDoWorker(S__dnsDoWork);                                        // URC parsing and stale entry refresh
+}
+
+
+/**
+ *	@brief Resolve a host name to an IP address, using the cache if entry is valid.
+ */
+resultCode_t dns_resolve(const char *hostName, char *ipAddr, uint8_t ipAddrSz)
+{
+    ASSERT(g_lqLTEM.dnsCache != NULL);
+    dnsCache_t *dnsCache = g_lqLTEM.dnsCache;
+
+    const char *cachedIp = dns_getCached(hostName);
+    if (cachedIp != NULL)
+    {
+        strncpy(ipAddr, cachedIp, ipAddrSz - 1);
+        return resultCode__success;
+    }
+    dnsCache->statsMisses++;
+
+    uint32_t waitStart = pMillis();
+    while (dnsCache->queryIndx >= 0)                                            // background query underway, BGx processes one at a time
+    {
+        ltem_eventMgr();
+        if (pElapsed(waitStart, dns__resolveTimeoutMS))
+            return resultCode__timeout;
+        pYield();
+    }
+
+    int8_t entryIndx = S__dnsFindEntry(hostName);
+    if (entryIndx < 0)
+    {
+        entryIndx = S__dnsReplaceEntry();
+        memset(&dnsCache->entries[entryIndx], 0, sizeof(dnsEntry_t));
+        strncpy(dnsCache->entries[entryIndx].hostName, hostName, dns__hostNameSz - 1);
+    }
+
+    if (!S__dnsStartQuery(entryIndx))
+        return dnsCache->queryResult;
+
+    while (dnsCache->queryIndx >= 0)                                            // result is reported by URC(s), parsed by worker
+    {
+        ltem_eventMgr();
+        if (pElapsed(dnsCache->queryStart, dns__resolveTimeoutMS))
+        {
+            dnsCache->queryIndx = -1;
+            return resultCode__timeout;
+        }
+        pYield();
+    }
+
+    if (dnsCache->queryResult == resultCode__success)
+    {
+        strncpy(ipAddr, dnsCache->entries[entryIndx].ipAddr, ipAddrSz - 1);
+    }
+    return dnsCache->queryResult;
+}
+
+
+/**
+ *	@brief Get the cached IP address for a host name, without a BGx query. 
+ */
+const char* dns_getCached(const char *hostName)
+{
+    if (g_lqLTEM.dnsCache == NULL)
+        return NULL;
+
+    int8_t entryIndx = S__dnsFindEntry(hostName);
+    if (entryIndx < 0)
+        return NULL;
+
+    dnsEntry_t *entry = &g_lqLTEM.dnsCache->entries[entryIndx];
+    if (strlen(entry->ipAddr) == 0)
+        return NULL;
+
+    uint32_t age = pMillis() - entry->resolvedAt;
+    if (age > entry->ttlMs + PERIOD_FROM_SECONDS(dns__staleMaxSec))             // too old to use, treat as miss
+        return NULL;
+
+    entry->lastUsedAt = pMillis();
+    if (age > entry->ttlMs)
+    {
+        entry->refreshPending = true;                                           // stale-while-revalidate
+        g_lqLTEM.dnsCache->statsStaleHits++;
+    }
+    else
+    {
+        g_lqLTEM.dnsCache->statsHits++;
+    }
+    return entry->ipAddr;
+}
+
+
+/**
+ *	@brief Discard all cached entries.
+ */
+void dns_flush()
+{
+    if (g_lqLTEM.dnsCache == NULL)
+        return;
+    memset(g_lqLTEM.dnsCache->entries, 0, sizeof(g_lqLTEM.dnsCache->entries));
+}
+
+
+/**
+ *	@brief Get the DNS cache state and statistics.
+ */
+dnsCache_t* dns_getCache()
+{
+    return g_lqLTEM.dnsCache;
+}
+
+
+#pragma endregion
+
+
+#pragma region private local static functions
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ *	@brief Resolver used by stream opens (g_lqLTEM.dnsResolver); returns the IP address, or the host name if it can't be resolved.
+ */
+static const char* S__dnsResolveHost(const char *hostName)
+{
+    if (S__isIpAddress(hostName))
+        return hostName;
+
+    char ipAddr[dns__ipAddrSz] = {0};
+    if (dns_resolve(hostName, ipAddr, sizeof(ipAddr)) == resultCode__success)
+    {
+        int8_t entryIndx = S__dnsFindEntry(hostName);
+        if (entryIndx >= 0)
+            return g_lqLTEM.dnsCache->entries[entryIndx].ipAddr;               // return persistent copy
+    }
+    return hostName;                                                            // fallback, BGx will resolve on open
+}
+
+
+/**
+ *	@brief DNS background worker; parses query result URCs and refreshes stale entries.
+ */
+static void S__dnsDoWork()
+{
+    dnsCache_t *dnsCache = g_lqLTEM.dnsCache;
+
+    S__dnsParseUrc();
+
+    if (dnsCache->queryIndx >= 0 || ATCMD_isLockActive())                      // query underway or busy, check back next pass
+        return;
+
+    for (uint8_t i = 0; i < dns__cacheCnt; i++)
+    {
+        if (dnsCache->entries[i].refreshPending)
+        {
+            S__dnsStartQuery(i);
+            return;                                                             // BGx processes one query at a time
+        }
+    }
+}
+
+
+/**
+ *	@brief Parse DNS query result URCs.
+ *  @details Only a URC at the head of rxBffr is parsed, anything preceding it (other URCs) is left for its owner. Not parsed 
+ *           while a command is active, the URC is then popped with the command response.
+ */
+static void S__dnsParseUrc()
+{
+    /* +QIURC: "dnsgip",<err>,<IP_count>,<DNS_ttl>
+     * +QIURC: "dnsgip","<IP_addr>"                 repeated IP_count times
+     */
+    cBuffer_t *rxBffr = g_lqLTEM.iop->rxBffr;                                   // for convenience
+
+    if (ATCMD_isLockActive())
+        return;
+
+    while (true)
+    {
+        int16_t urcIndx = cbffr_find(rxBffr, "+QIURC: \"dnsgip\",", 0, 0, false);
+        if (CBFFR_NOTFOUND(urcIndx) || urcIndx > 2)                             // not at head (2 = leading line-end), check back next pass
+            return;
+
+        char workBffr[DNS_URC_SZ + 1] = {0};
+        int16_t eolIndx = cbffr_find(rxBffr, "\r\n", urcIndx, DNS_URC_SZ, false);
+        if (CBFFR_NOTFOUND(eolIndx))
+            return;                                                             // don't have full URC line yet, come back later
+
+        cbffr_skipTail(rxBffr, urcIndx);
+        cbffr_pop(rxBffr, workBffr, eolIndx - urcIndx + 2);
+        S__dnsParseUrcLine(workBffr);
+    }
+}
+
+
+/**
+ *	@brief Apply a DNS query result URC line to the query underway.
+ *  @param urcLine [in] URC line, starting at +QIURC: "dnsgip",
+ */
+static void S__dnsParseUrcLine(const char *urcLine)
+{
+    dnsCache_t *dnsCache = g_lqLTEM.dnsCache;
+    char *workPtr = (char*)urcLine + sizeof("+QIURC: \"dnsgip\",") - 1;
+
+    if (dnsCache->queryIndx < 0)                                                // not our query (timed out), discard
+        return;
+    dnsEntry_t *entry = &dnsCache->entries[dnsCache->queryIndx];
+
+    if (*workPtr == '"')                                                        // IP address line
+    {
+        workPtr++;
+        char *endPtr = strchr(workPtr, '"');
+        if (endPtr != NULL && dnsCache->queryResult == resultCode__unknown)    // first address is used
+        {
+            memset(entry->ipAddr, 0, dns__ipAddrSz);
+            memcpy(entry->ipAddr, workPtr, MIN(endPtr - workPtr, dns__ipAddrSz - 1));
+            entry->resolvedAt = pMillis();
+            entry->refreshPending = false;
+            dnsCache->queryResult = resultCode__success;
+        }
+        if (dnsCache->queryIpRemaining > 0)
+            dnsCache->queryIpRemaining--;
+    }
+    else                                                                        // result header line
+    {
+        uint16_t errCode = strtol(workPtr, &workPtr, 10);
+        if (errCode != 0)
+        {
+            dnsCache->queryResult = errCode;                                    // BGx error (565 = DNS parse failed)
+            entry->refreshPending = false;                                      // stale entry kept (resolvedAt unchanged), retried on next use
+            dnsCache->queryIpRemaining = 0;
+        }
+        else
+        {
+            dnsCache->queryIpRemaining = strtol(workPtr + 1, &workPtr, 10);
+            uint32_t ttlSec = strtol(workPtr + 1, NULL, 10);
+            entry->ttlMs = PERIOD_FROM_SECONDS((ttlSec > 0) ? ttlSec : dns__defaultTtlSec);
+        }
+    }
+
+    if (dnsCache->queryIpRemaining == 0 && dnsCache->queryResult != resultCode__unknown)
+    {
+        PRINTF(dbgColor__cyan, "dnsUrc() host=%s ip=%s rslt=%d %lums\r", entry->hostName, entry->ipAddr, dnsCache->queryResult, pMillis() - dnsCache->queryStart);
+        dnsCache->queryIndx = -1;                                               // query complete
+    }
+}
+
+
+/**
+ *	@brief Start a BGx DNS query for an entry; result is reported by URC.
+ */
+static bool S__dnsStartQuery(uint8_t entryIndx)
+{
+    dnsCache_t *dnsCache = g_lqLTEM.dnsCache;
+    uint8_t pdpCntxt = (dnsCache->pdpCntxt == 0) ? g_lqLTEM.providerInfo->defaultContext : dnsCache->pdpCntxt;
+
+    dnsCache->queryResult = resultCode__unknown;
+    dnsCache->queryIpRemaining = 0;
+    dnsCache->queryStart = pMillis();
+    dnsCache->queryIndx = entryIndx;                                            // set before invoke, URC can follow OK immediately
+
+    if (atcmd_tryInvoke("AT+QIDNSGIP=%d,\"%s\"", pdpCntxt, dnsCache->entries[entryIndx].hostName))
+    {
+        resultCode_t rslt = atcmd_awaitResult();
+        if (rslt == resultCode__success)
+        {
+            char *urcPtr = atcmd_getRawResponse();                              // URC(s) received with OK, popped into response
+            while ((urcPtr = strstr(urcPtr, "+QIURC: \"dnsgip\",")) != NULL && strstr(urcPtr, "\r\n") != NULL)
+            {
+                S__dnsParseUrcLine(urcPtr);
+                urcPtr = strstr(urcPtr, "\r\n");
+            }
+            return true;
+        }
+        dnsCache->queryResult = rslt;
+    }
+    else
+    {
+        dnsCache->queryResult = resultCode__conflict;
+    }
+    dnsCache->queryIndx = -1;
+    return false;
+}
+
+
+/**
+ *	@brief Find cache entry for host name.
+ */
+static int8_t S__dnsFindEntry(const char *hostName)
+{
+    for (uint8_t i = 0; i < dns__cacheCnt; i++)
+    {
+        if (strncmp(g_lqLTEM.dnsCache->entries[i].hostName, hostName, dns__hostNameSz) == 0)
+            return i;
+    }
+    return -1;
+}
+
+
+/**
+ *	@brief Select cache entry to hold a new host name: an empty entry or the least recently used.
+ */
+static uint8_t S__dnsReplaceEntry()
+{
+    uint8_t replaceIndx = 0;
+    for (uint8_t i = 0; i < dns__cacheCnt; i++)
+    {
+        dnsEntry_t *entry = &g_lqLTEM.dnsCache->entries[i];
+        if (strlen(entry->hostName) == 0)
+            return i;
+        if (i != g_lqLTEM.dnsCache->queryIndx && 
+            (pMillis() - entry->lastUsedAt) > (pMillis() - g_lqLTEM.dnsCache->entries[replaceIndx].lastUsedAt))
+            replaceIndx = i;
+    }
+    return replaceIndx;
+}
+
+
+/**
+ *	@brief Test if host is already an IP address (IPv4 dotted or IPv6), no resolution required.
+ */
+static bool S__isIpAddress(const char *hostName)
+{
+    if (strchr(hostName, ':') != NULL)                                          // IPv6, host names do not contain ':'
+        return true;
+
+    for (const char *chPtr = hostName; *chPtr; chPtr++)
+    {
+        if (!((*chPtr >= '0' && *chPtr <= '9') || *chPtr == '.'))
+            return false;
+    }
+    return true;
+}
+
+
+#pragma endregion
@@ -0,0 +1,134 @@
+/** ****************************************************************************
+  \file 
+  \author Greg Terrell, LooUQ Incorporated
+
+  \loouq
+
+--------------------------------------------------------------------------------
+
+    This project is released under the GPL-3.0 License.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ 
+***************************************************************************** */
+
+
+
+
+#ifndef __LTEMC_DNS_H__
+#define __LTEMC_DNS_H__
+
+#include <lq-types.h>
+#include "ltemc-types.h"
+
+
+/** 
+ *  @brief Typed numeric constants for the DNS cache subsystem
+ */
+enum dns__constants
+{
+    dns__cacheCnt = 4,                      /// number of host names cached
+    dns__hostNameSz = 64,
+    dns__ipAddrSz = 40,                     /// IPv6 text max (39) + \0
+    dns__defaultTtlSec = 300,               /// TTL used if BGx reports none
+    dns__staleMaxSec = 86400,               /// stale entry is served (and refreshed) for up to this age past TTL
+    dns__resolveTimeoutMS = 60000           /// BGx DNS query max duration
+};
+
+
+/** 
+ *  @brief Cached host name to IP address entry.
+*/
+typedef struct dnsEntry_tag
+{
+    char hostName[dns__hostNameSz];
+    char ipAddr[dns__ipAddrSz];             /// resolved address (first address reported), empty if not resolved
+    uint32_t resolvedAt;                    /// tick count of last successful resolution
+    uint32_t ttlMs;                         /// time to live reported by BGx
+    uint32_t lastUsedAt;                    /// tick count of last lookup, for cache replacement
+    bool refreshPending;                    /// entry is stale, background worker will re-resolve
+} dnsEntry_t;
+
+
+/** 
+ *  @brief DNS cache state.
+*/
+typedef struct dnsCache_tag
+{
+    uint8_t pdpCntxt;                       /// PDP context for DNS queries, 0 = network default
+    dnsEntry_t entries[dns__cacheCnt];
+    int8_t queryIndx;                       /// entry with BGx query underway, -1 = none
+    uint8_t queryIpRemaining;               /// count of IP address URC lines expected for query
+    resultCode_t queryResult;               /// result of last query, resultCode__unknown while underway
+    uint32_t queryStart;
+    uint32_t statsHits;                     /// lookups satisfied by fresh entry
+    uint32_t statsStaleHits;                /// lookups satisfied by stale entry (refreshed in background)
+    uint32_t statsMisses;                   /// lookups requiring BGx query
+} dnsCache_t;
+
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+
+/**
+ *	@brief Create the DNS cache and enable its use for socket/MQTT/HTTP opens.
+ *  @details Hosts specified by name are resolved with AT+QIDNSGIP and cached for the DNS reported TTL. Opens use the cached 
+ *           IP address; an expired entry continues to be used while it is re-resolved in the background (ltem_eventMgr()).
+ *           TLS connections and HTTP (without custom headers) continue to open by name, the host name is required for 
+ *           certificate validation (SNI) and the HTTP Host header.
+ *  @param pdpCntxt [in] PDP context for DNS queries, 0 = network default context.
+ */
+void dns_create(uint8_t pdpCntxt);
+
+
+/**
+ *	@brief Resolve a host name to an IP address, using the cache if entry is valid.
+ *  @param hostName [in] Host name to resolve.
+ *  @param ipAddr [out] Buffer for IP address.
+ *  @param ipAddrSz [in] Size of ipAddr buffer.
+ *  @return Result code similar to http status code, OK = 200
+ */
+resultCode_t dns_resolve(const char *hostName, char *ipAddr, uint8_t ipAddrSz);
+
+
+/**
+ *	@brief Get the cached IP address for a host name, without a BGx query. 
+ *  @param hostName [in] Host name to find.
+ *  @return Pointer to IP address, NULL if not cached
+ */
+const char* dns_getCached(const char *hostName);
+
+
+/**
+ *	@brief Discard all cached entries.
+ */
+void dns_flush();
+
+
+/**
+ *	@brief Get the DNS cache state and statistics.
+ *  @return Pointer to DNS cache, NULL if not created.
+ */
+dnsCache_t* dns_getCache();
+
+
+#ifdef __cplusplus
+}
+#endif // !__cplusplus
+
+#endif  /* !__LTEMC_DNS_H__ */
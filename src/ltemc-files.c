@@ -167,6 +167,28 @@ resultCode_t file_getFilelist(fileListResult_t *fileList, const char* filename)
 }
 
 
+/**
+ *	@brief Get the size of a file in the filesystem.
+ */
+resultCode_t file_getFileSize(const char* filename, uint32_t *fileSz)
+{
+    *fileSz = 0;
+    if (atcmd_tryInvoke("AT+QFLST=\"%s\"", filename))
+    {
+        resultCode_t rslt = atcmd_awaitResult();
+        if (rslt == resultCode__success)
+        {
+            char *workPtr = strstr(atcmd_getResponse(), "\",");                // +QFLST: "<filename>",<file_size>
+            if (workPtr == NULL)
+                return resultCode__notFound;
+            *fileSz = strtol(workPtr + 2, NULL, 10);
+        }
+        return rslt;
+    }
+    return resultCode__conflict;
+}
+
+
 resultCode_t file_open(const char* filename, fileOpenMode_t openMode, uint16_t* fileHandle)
 {
     ASSERT(strlen(filename) > 0);                                           // assert user provided a filename
@@ -291,7 +313,29 @@ resultCode_t file_read(uint16_t fileHandle, uint16_t readSz)
         atcmd_configDataMode(0, "CONNECT", S__filesRxHndlr, NULL, 0, g_lqLTEM.fileCtrl->appRecvDataCB, true);
         // atcmd_setStreamControl("CONNECT", g_lqLTEM.fileCtrl);
         g_lqLTEM.fileCtrl->handle = fileHandle;
-        return atcmd_awaitResult() == resultCode__success;                     // dataHandler will be invoked by atcmd module and return a resultCode
+        return atcmd_awaitResult();                                             // dataHandler will be invoked by atcmd module and return a resultCode
+    }
+    return resultCode__conflict;
+}
+
+
+resultCode_t file_readBuffer(uint16_t fileHandle, char *buffer, uint16_t readSz, uint16_t *readCnt)
+{
+    ASSERT(buffer != NULL && readSz > 0);
+
+    *readCnt = 0;
+    if (atcmd_tryInvoke("AT+QFREAD=%d,%d", fileHandle, readSz))
+    {
+        atcmd_configDataMode(0, "CONNECT", S__filesRxHndlr, NULL, 0, NULL, true);
+        g_lqLTEM.fileCtrl->handle = fileHandle;
+        g_lqLTEM.fileCtrl->readBffr = buffer;                                  // S__filesRxHndlr() copies to buffer
+        g_lqLTEM.fileCtrl->readBffrSz = readSz;
+        g_lqLTEM.fileCtrl->readCnt = 0;
+
+        resultCode_t rslt = atcmd_awaitResult();
+        *readCnt = g_lqLTEM.fileCtrl->readCnt;
+        g_lqLTEM.fileCtrl->readBffr = NULL;
+        return rslt;
     }
     return resultCode__conflict;
 }
@@ -366,7 +410,7 @@ resultCode_t file_getPosition(uint16_t fileHandle, uint32_t* filePtr)
  */
 resultCode_t file_truncate(uint16_t fileHandle)
 {
-    if (atcmd_tryInvokeAdv("AT+QFTUCAT=%d", fileHandle))
+    if (atcmd_tryInvoke("AT+QFTUCAT=%d", fileHandle))
     {
         return atcmd_awaitResult();
     }
@@ -379,7 +423,7 @@ resultCode_t file_truncate(uint16_t fileHandle)
  */
 resultCode_t file_delete(const char* filename)
 {
-    if (atcmd_tryInvoke("AT+QFDEL=%s", filename))
+    if (atcmd_tryInvoke("AT+QFDEL=\"%s\"", filename))
     {
         return atcmd_awaitResult();
     }
@@ -443,15 +487,23 @@ static resultCode_t S__filesRxHndlr()
             char* streamPtr;
             uint16_t blockSz = cbffr_popBlock(g_lqLTEM.iop->rxBffr, &streamPtr, readSz);                        // get address from rxBffr
             PRINTF(dbgColor__cyan, "filesRxHndlr() ptr=%p, bSz=%d, rSz=%d\r", streamPtr, blockSz, readSz);
-            ((fileReceiver_func)(*g_lqLTEM.fileCtrl->appRecvDataCB))(g_lqLTEM.fileCtrl->handle, streamPtr, blockSz);                  // forward to application
+            if (g_lqLTEM.fileCtrl->readBffr != NULL)                                                            // file_readBuffer(), copy to caller buffer
+            {
+                uint16_t copySz = MIN(blockSz, g_lqLTEM.fileCtrl->readBffrSz - g_lqLTEM.fileCtrl->readCnt);
+                memcpy(g_lqLTEM.fileCtrl->readBffr + g_lqLTEM.fileCtrl->readCnt, streamPtr, copySz);
+                g_lqLTEM.fileCtrl->readCnt += copySz;
+            }
+            else
+                ((fileReceiver_func)(*g_lqLTEM.fileCtrl->appRecvDataCB))(g_lqLTEM.fileCtrl->handle, streamPtr, blockSz);              // forward to application
             cbffr_popBlockFinalize(g_lqLTEM.iop->rxBffr, true);                                                 // commit POP
             readSz -= blockSz;
             streamSz -= blockSz;
         }
 
-        if (cbffr_getOccupied(g_lqLTEM.iop->rxBffr) >= file__readTrailerSz)                                     // cleanup, remove trailer
+        if (readSz == 0 && cbffr_getOccupied(g_lqLTEM.iop->rxBffr) >= file__readTrailerSz)                      // cleanup, remove trailer
         {
             cbffr_skipTail(g_lqLTEM.iop->rxBffr, file__readTrailerSz);
+            streamSz -= file__readTrailerSz;
         }
     }
     return resultCode__success;
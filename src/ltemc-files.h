@@ -153,6 +153,15 @@ resultCode_t file_getFSInfo(filesysInfo_t * fsInfo);
 resultCode_t file_getFilelist(fileListResult_t *filelist, const char* fileName);
 
 
+/**
+ *	@brief Get the size of a file in the filesystem.
+ *	@param [in] fileName - Name of the file.
+ *	@param [out] fileSz - File size in bytes, 0 if file is not found.
+ *  @return ResultCode=200 if successful, otherwise error code (HTTP status type).
+ */
+resultCode_t file_getFileSize(const char* fileName, uint32_t *fileSz);
+
+
 // /**
 //  *	@brief set file read data receiver function (here or with filesys_open). Not required if file is write only access.
 //  */
@@ -201,6 +210,17 @@ resultCode_t file_closeAll();
 resultCode_t file_read(uint16_t fileHandle, uint16_t readSz);
 
 
+/**
+ *	@brief Read from file into a buffer at the current file position (no app receiver required).
+ *	@param [in] fileHandle - Numeric handle for the file to read.
+ *	@param [out] buffer - Buffer to receive file data.
+ *	@param [in] readSz - Number of bytes to read (buffer size).
+ *	@param [out] readCnt - Number of bytes read, less than readSz at end-of-file.
+ *  @return ResultCode=200 if successful, otherwise error code (HTTP status type).
+ */
+resultCode_t file_readBuffer(uint16_t fileHandle, char *buffer, uint16_t readSz, uint16_t *readCnt);
+
+
 /**
  *	@brief Closes the file. 
  *	@param [in] fileHandle - Numeric handle for the file to close.
@@ -28,6 +28,7 @@
 #define SRCFILE "HTT"                           // create SRCFILE (3 char) MACRO for lq-diagnostics ASSERT
 #include "ltemc-internal.h"
 #include "ltemc-http.h"
+#include "ltemc-files.h"
 
 #define _DEBUG 2                        // set to non-zero value for PRINTF debugging output, 
 // debugging output options             // LTEm1c will satisfy PRINTF references with empty definition if not already resolved
@@ -53,10 +54,22 @@ extern ltemDevice_t g_lqLTEM;
 ------------------------------------------------------------------------------------------------------------------------- */
 // static void S_httpDoWork();
 static uint16_t S__parseResponseForHttpStatus(httpCtrl_t *httpCtrl, const char *responseTail);
+static resultCode_t S__httpGet(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs, uint32_t rangeStart, uint32_t rangeSz);
+static resultCode_t S__httpPost(httpCtrl_t *httpCtrl, const char *relativeUrl, bool returnResponseHdrs, uint32_t bodySz, char *workBffr, uint16_t workBffrSz, const char *filename);
+static resultCode_t S__httpRequestTxDataHndlr();
 static uint16_t S__setUrl(const char *host, const char *relative);
+static resultCode_t S__applyCfg(const char *cfgName, int8_t *appliedValue, int8_t value);
+static uint16_t S__composeRequestLine(httpCtrl_t *httpCtrl, const char *relativeUrl, char *rqstLine, uint16_t rqstLineSz);
+static uint32_t S__requestHdrsSz(httpCtrl_t *httpCtrl);
+static void S__validateCfgState();
+static void S__getHostUrl(httpCtrl_t *httpCtrl, char *hostUrl, uint16_t hostUrlSz);
 static cmdParseRslt_t S__httpGetStatusParser();
 static cmdParseRslt_t S__httpPostStatusParser();
+static cmdParseRslt_t S__httpPostFileStatusParser();
 static resultCode_t S__httpRxHndlr();
+static resultCode_t S__httpUrcHndlr();
+static void S__httpReadFileDone(httpCtrl_t *httpCtrl, const char *urcLine);
+static resultCode_t S__appendFile(const char *destFilename, const char *srcFilename, char *bffr, uint16_t bffrSz);
 
 
 /* Public Functions
@@ -72,11 +85,19 @@ void http_initControl(httpCtrl_t *httpCtrl, dataCntxt_t dataCntxt, httpRecv_func
 
     g_lqLTEM.streams[dataCntxt] = httpCtrl;
 
+    if (g_lqLTEM.httpCfg == NULL)
+    {
+        g_lqLTEM.httpCfg = calloc(1, sizeof(httpCfgState_t));                  // BGx settings shared by all HTTP streams, initially unknown
+        ASSERT(g_lqLTEM.httpCfg != NULL);
+    }
+
     memset(httpCtrl, 0, sizeof(httpCtrl_t));
 
     httpCtrl->streamType = streamType_HTTP;
+    httpCtrl->dataCntxt = dataCntxt;
     httpCtrl->appRecvDataCB = recvCallback;
     httpCtrl->dataRxHndlr = S__httpRxHndlr;
+    httpCtrl->urcEvntHndlr = S__httpUrcHndlr;                               // file response completion
 
     httpCtrl->requestState = httpState_idle;
     httpCtrl->httpStatus = resultCode__unknown;
@@ -209,35 +230,52 @@ void http_addBasicAuthHdr(httpCtrl_t *http, const char *user, const char *pw)
  *  -----------------------------------------------------------------------------------------------
  */
 resultCode_t http_get(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs)
+{
+    return S__httpGet(httpCtrl, relativeUrl, returnResponseHdrs, 0, 0);
+}
+
+
+/**
+ *	@brief Perform HTTP GET operation for a byte range of the resource.
+ *  -----------------------------------------------------------------------------------------------
+ */
+resultCode_t http_getRange(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs, uint32_t rangeStart, uint32_t rangeSz)
+{
+    ASSERT(rangeSz > 0);
+    return S__httpGet(httpCtrl, relativeUrl, returnResponseHdrs, rangeStart, rangeSz);
+}
+
+
+/**
+ *	@brief Perform HTTP GET, optionally for a byte range of the resource (rangeSz > 0).
+ *  @details Range is requested with a Range header when custom headers are enabled, otherwise with AT+QHTTPGETEX.
+ */
+static resultCode_t S__httpGet(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs, uint32_t rangeStart, uint32_t rangeSz)
 {
     httpCtrl->requestState = httpState_idle;
     httpCtrl->httpStatus = resultCode__unknown;
     strcpy(httpCtrl->requestType, "GET");
     resultCode_t rslt;
 
+    char hostUrl[host__urlSz] = {0};
+    S__getHostUrl(httpCtrl, hostUrl, sizeof(hostUrl));                                          // resolve (DNS cache) before command lock is taken
+
     if (ATCMD_awaitLock(httpCtrl->timeoutSec))
     {
-        if (returnResponseHdrs)
-        {
-            atcmd_invokeReuseLock("AT+QHTTPCFG=\"responseheader\",%d",  (int)(httpCtrl->returnResponseHdrs));
-            rslt = atcmd_awaitResultWithOptions(atcmd__defaultTimeout, NULL);
-            if (rslt != resultCode__success)
-            {
-                atcmd_close();
-                return rslt;
-            }
-        }
+        S__validateCfgState();
+        httpCtrl->returnResponseHdrs = returnResponseHdrs;
 
-        if (httpCtrl->useTls)
+        /* BGx HTTP settings are shared by all HTTP streams and persist between requests, only changed settings are sent
+         */
+        rslt = S__applyCfg("responseheader", &g_lqLTEM.httpCfg->responseHdrs, returnResponseHdrs);
+        if (rslt == resultCode__success && httpCtrl->useTls)
+            rslt = S__applyCfg("sslctxid", &g_lqLTEM.httpCfg->sslCtxId, httpCtrl->dataCntxt);
+        if (rslt == resultCode__success)
+            rslt = S__applyCfg("requestheader", &g_lqLTEM.httpCfg->requestHdrs, httpCtrl->cstmHdrs ? 1 : 0);       // if custom headers, need to both set flag here and include in request stream below
+        if (rslt != resultCode__success)
         {
-            // AT+QHTTPCFG="sslctxid",<httpCtrl->sckt>
-            atcmd_invokeReuseLock("AT+QHTTPCFG=\"sslctxid\",%d",  (int)httpCtrl->dataCntxt);
-            rslt = atcmd_awaitResult();
-            if (rslt != resultCode__success)
-            {
-                atcmd_close();
-                return rslt;
-            }
+            atcmd_close();
+            return rslt;
         }
 
         /* SET URL FOR REQUEST
@@ -247,7 +285,7 @@ resultCode_t http_get(httpCtrl_t *httpCtrl, const char* relativeUrl, bool return
         * NOTE: there is only 1 URL in the BGx at a time
         *---------------------------------------------------------------------------------------------------------------*/
 
-        rslt = S__setUrl(httpCtrl->hostUrl, relativeUrl);
+        rslt = S__setUrl(hostUrl, relativeUrl);
         if (rslt != resultCode__success)
         {
             PRINTF(dbgColor__warn, "Failed set URL rslt=%d\r", rslt);
@@ -264,35 +302,37 @@ resultCode_t http_get(httpCtrl_t *httpCtrl, const char* relativeUrl, bool return
         * but non-LTEm tasks like reading sensors can continue.
         *---------------------------------------------------------------------------------------------------------------*/
 
-        /* If custom headers, need to both set flag here and include in request stream below
-         */
-        atcmd_invokeReuseLock("AT+QHTTPCFG=\"requestheader\",%d", httpCtrl->cstmHdrs ? 1 : 0);
-        rslt = atcmd_awaitResult();
-        if (rslt != resultCode__success)
+        char rqstLine[http__rqstLineSz] = {0};
+        char rangeHdr[http__sizeHdrSz] = {0};
+        if (httpCtrl->cstmHdrs)
         {
-            atcmd_close();
-            return rslt;
+            if (S__composeRequestLine(httpCtrl, relativeUrl, rqstLine, sizeof(rqstLine)) == 0)
+            {
+                atcmd_close();
+                return resultCode__badRequest;
+            }
+            if (rangeSz > 0)
+                snprintf(rangeHdr, sizeof(rangeHdr), "Range: bytes=%lu-%lu\r\n", rangeStart, rangeStart + rangeSz - 1);
+            httpCtrl->txRqstLine = rqstLine;
+            httpCtrl->txSizeHdr = rangeHdr;
+            httpCtrl->txBody = NULL;                                                                    // request is headers only
+            httpCtrl->txRemaining = 0;
+
+            atcmd_configDataMode(httpCtrl->dataCntxt, "CONNECT", S__httpRequestTxDataHndlr, NULL, 0, NULL, false);
+            atcmd_invokeReuseLock("AT+QHTTPGET=%d,%lu", httpCtrl->timeoutSec, S__requestHdrsSz(httpCtrl));
         }
-
-        char httpRequestCmd[http__getRequestLength];
-        if (httpCtrl->cstmHdrs)
+        else if (rangeSz > 0)
         {
-            char *hostName = strchr(httpCtrl->hostUrl, ':');
-            hostName = hostName ? hostName + 3 : httpCtrl->hostUrl;
-
-            char cstmRequest[240];
-            snprintf(cstmRequest, sizeof(cstmRequest), "%s %s HTTP/1.1\r\nHost: %s\r\n%s\r\n", httpCtrl->requestType, relativeUrl, hostName, httpCtrl->cstmHdrs);
-            PRINTF(dbgColor__dMagenta, "CustomRqst:\r%s\r", cstmRequest);
-
-            atcmd_configDataMode(httpCtrl->dataCntxt, "CONNECT", atcmd_stdTxDataHndlr, cstmRequest, strlen(cstmRequest), NULL, false);
-            atcmd_invokeReuseLock("AT+QHTTPGET=%d,%d", httpCtrl->timeoutSec, strlen(cstmRequest));
+            atcmd_invokeReuseLock("AT+QHTTPGETEX=%d,%lu,%lu", httpCtrl->timeoutSec, rangeStart, rangeSz);   // response is +QHTTPGET
         }
         else
         {
-            atcmd_invokeReuseLock("AT+QHTTPGET=%d", PERIOD_FROM_SECONDS(httpCtrl->timeoutSec));
+            atcmd_invokeReuseLock("AT+QHTTPGET=%d", httpCtrl->timeoutSec);
         }
 
         rslt = atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(httpCtrl->timeoutSec), S__httpGetStatusParser);                                                                     // wait for "+QHTTPGET trailer (request completed)
+        httpCtrl->txRqstLine = NULL;
+        httpCtrl->txSizeHdr = NULL;
         if (rslt == resultCode__success && atcmd_getValue() == 0)
         {
             httpCtrl->httpStatus = S__parseResponseForHttpStatus(httpCtrl, atcmd_getResponse());
@@ -312,7 +352,7 @@ resultCode_t http_get(httpCtrl_t *httpCtrl, const char* relativeUrl, bool return
         return httpCtrl->httpStatus;
     }
     return resultCode__timeout;
-}   /* http_get() */
+}   /* S__httpGet() */
 
 
 
@@ -321,36 +361,81 @@ resultCode_t http_get(httpCtrl_t *httpCtrl, const char* relativeUrl, bool return
  *  -----------------------------------------------------------------------------------------------
  */
 resultCode_t http_post(httpCtrl_t *httpCtrl, const char *relativeUrl, bool returnResponseHdrs, const char *postData, uint16_t postDataSz)
+{
+    httpCtrl->txBody = postData;
+    httpCtrl->txProducer = NULL;
+    return S__httpPost(httpCtrl, relativeUrl, returnResponseHdrs, postDataSz, NULL, 0, NULL);
+}
+
+
+/**
+ *	@brief Performs a HTTP POST page web request with the body supplied in chunks by a producer.
+ *  -----------------------------------------------------------------------------------------------
+ */
+resultCode_t http_postStream(httpCtrl_t *httpCtrl, const char *relativeUrl, bool returnResponseHdrs, uint32_t bodySz, httpPostProducer_func producer, char *workBffr, uint16_t workBffrSz, httpPostResult_t *postResult)
+{
+    ASSERT(producer != NULL && workBffr != NULL && workBffrSz >= 2);
+    ASSERT(bodySz > 0);
+
+    uint32_t startTime = pMillis();
+    httpCtrl->txBody = NULL;
+    httpCtrl->txProducer = producer;
+    httpCtrl->txRemaining = bodySz;
+    httpCtrl->txChunks = 0;
+    resultCode_t rslt = S__httpPost(httpCtrl, relativeUrl, returnResponseHdrs, bodySz, workBffr, workBffrSz, NULL);
+    httpCtrl->txProducer = NULL;
+
+    if (postResult != NULL)
+    {
+        postResult->bytesSent = bodySz - httpCtrl->txRemaining;
+        postResult->chunks = httpCtrl->txChunks;
+        postResult->durationMs = pMillis() - startTime;
+        postResult->throughputBps = (postResult->durationMs > 0) ? (uint32_t)(((uint64_t)postResult->bytesSent * 1000) / postResult->durationMs) : postResult->bytesSent;
+        PRINTF(dbgColor__dYellow, "PostStream rslt=%d bytes=%lu chunks=%d %lums %luB/s\r", rslt, postResult->bytesSent, postResult->chunks, postResult->durationMs, postResult->throughputBps);
+    }
+    return rslt;
+}
+
+
+/**
+ *	@brief Performs a HTTP POST page web request with the body read by the BGx from a file (UFS).
+ *  -----------------------------------------------------------------------------------------------
+ */
+resultCode_t http_postFile(httpCtrl_t *httpCtrl, const char *relativeUrl, bool returnResponseHdrs, const char *filename)
+{
+    ASSERT(strlen(filename) > 0);
+    return S__httpPost(httpCtrl, relativeUrl, returnResponseHdrs, 0, NULL, 0, filename);
+}
+
+
+/**
+ *	@brief POST request: body from RAM (txBody), producer (txProducer) or BGx file (filename != NULL).
+ *  @details With custom headers the request line and headers are sent ahead of the body (BGx requestheader mode).
+ */
+static resultCode_t S__httpPost(httpCtrl_t *httpCtrl, const char *relativeUrl, bool returnResponseHdrs, uint32_t bodySz, char *workBffr, uint16_t workBffrSz, const char *filename)
 {
     httpCtrl->requestState = httpState_idle;
     httpCtrl->httpStatus = resultCode__unknown;
     strcpy(httpCtrl->requestType, "POST");
     resultCode_t rslt;
 
+    char hostUrl[host__urlSz] = {0};
+    S__getHostUrl(httpCtrl, hostUrl, sizeof(hostUrl));                                          // resolve (DNS cache) before command lock is taken
+
     if (ATCMD_awaitLock(httpCtrl->timeoutSec))
     {
-        if (returnResponseHdrs)
-        {
-            atcmd_invokeReuseLock("AT+QHTTPCFG=\"responseheader\",%d",  (int)(httpCtrl->returnResponseHdrs));
+        S__validateCfgState();
+        httpCtrl->returnResponseHdrs = returnResponseHdrs;
 
-            rslt = atcmd_awaitResult();
-            if (rslt != resultCode__success)
-            {
-                atcmd_close();
-                return rslt;
-            }
-        }
-
-        if (httpCtrl->useTls)
+        rslt = S__applyCfg("responseheader", &g_lqLTEM.httpCfg->responseHdrs, returnResponseHdrs);
+        if (rslt == resultCode__success && httpCtrl->useTls)
+            rslt = S__applyCfg("sslctxid", &g_lqLTEM.httpCfg->sslCtxId, httpCtrl->dataCntxt);
+        if (rslt == resultCode__success)
+            rslt = S__applyCfg("requestheader", &g_lqLTEM.httpCfg->requestHdrs, httpCtrl->cstmHdrs ? 1 : 0);       // custom headers are sent ahead of body
+        if (rslt != resultCode__success)
         {
-            // AT+QHTTPCFG="sslctxid",<httpCtrl->sckt>
-            atcmd_invokeReuseLock("AT+QHTTPCFG=\"sslctxid\",%d",  (int)httpCtrl->dataCntxt);
-            rslt = atcmd_awaitResult();
-            if (rslt != resultCode__success)
-            {
-                atcmd_close();
-                return rslt;
-            }
+            atcmd_close();
+            return rslt;
         }
 
         /* SET URL FOR REQUEST
@@ -360,7 +445,7 @@ resultCode_t http_post(httpCtrl_t *httpCtrl, const char *relativeUrl, bool retur
         * NOTE: there is only 1 URL in the BGx at a time
         *---------------------------------------------------------------------------------------------------------------*/
 
-        rslt = S__setUrl(httpCtrl->hostUrl, relativeUrl);
+        rslt = S__setUrl(hostUrl, relativeUrl);
         if (rslt != resultCode__success)
         {
             PRINTF(dbgColor__warn, "Failed set URL rslt=%d\r", rslt);
@@ -369,60 +454,69 @@ resultCode_t http_post(httpCtrl_t *httpCtrl, const char *relativeUrl, bool retur
         }
 
         /* INVOKE HTTP ** POST ** METHOD
-        * BGx responds with OK immediately upon acceptance of cmd, then later (up to timeout) with "+QHTTPPOST: " string
-        * After "OK" we switch IOP to data mode and return. S_httpDoWork() handles the parsing of the page response and
-        * if successful, the issue of the AT+QHTTPREAD command to start the page data stream
+        * BGx responds with CONNECT, S__httpRequestTxDataHndlr() sends the request (custom headers, body) followed by OK. Then 
+        * later (up to timeout) with "+QHTTPPOST: " string.
         * 
-        * This allows other application tasks to be performed while waiting for page. No LTEm commands can be invoked
-        * but non-LTEm tasks like reading sensors can continue.
+        * With a file body the BGx reads the file, responding with "+QHTTPPOSTFILE: " when the request is complete. With 
+        * custom headers enabled the file holds the complete request (request line, headers and body).
         *---------------------------------------------------------------------------------------------------------------*/
         atcmd_reset(false);                                                                             // reset atCmd control struct WITHOUT clearing lock
 
-        char httpRequestCmd[http__postRequestLength];
-        uint16_t httpRequestLen = postDataSz;                                                           // requestLen starts with postDataSz
-        httpRequestLen += (httpCtrl->cstmHdrsSz > 0) ? (httpCtrl->cstmHdrsSz + 2) : 0;                  // add the custom headers + 2 char for EOL after hdrs
-
-        atcmd_configDataMode(httpCtrl->dataCntxt, "CONNECT", atcmd_stdTxDataHndlr, postData, postDataSz, NULL, false);
-
-        if (httpCtrl->cstmHdrsSz)
+        if (filename != NULL)
         {
-            atcmd_invokeReuseLock("AT+QHTTPPOST=%d,5,%d", httpRequestLen, httpCtrl->timeoutSec);
+            atcmd_invokeReuseLock("AT+QHTTPPOSTFILE=\"%s\",%d", filename, httpCtrl->timeoutSec);
+            rslt = atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(httpCtrl->timeoutSec), S__httpPostFileStatusParser);
         }
         else
         {
-            atcmd_invokeReuseLock("AT+QHTTPPOST=%d,5,%d", postDataSz, httpCtrl->timeoutSec);
-        }
-
-        rslt = atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(httpCtrl->timeoutSec), S__httpPostStatusParser);
-        if (rslt == resultCode__success)
-        {
-            // atcmd_reset(false);                                                                         // clear CONNECT event from atcmd results
-            // atcmd_sendCmdData(postData, postDataSz);
-            // rslt = atcmd_awaitResultWithOptions(httpCtrl->timeoutSec, S__httpPostStatusParser);
-            if (rslt == resultCode__success && atcmd_getValue() == 0)                                   // wait for "+QHTTPPOST trailer: rslt=200, postErr=0
+            char rqstLine[http__rqstLineSz] = {0};
+            char sizeHdr[http__sizeHdrSz] = {0};
+            if (httpCtrl->cstmHdrs)
             {
-                httpCtrl->httpStatus = S__parseResponseForHttpStatus(httpCtrl, atcmd_getResponse());
-                if (httpCtrl->httpStatus >= resultCode__success && httpCtrl->httpStatus <= resultCode__successMax)
+                if (S__composeRequestLine(httpCtrl, relativeUrl, rqstLine, sizeof(rqstLine)) == 0)
                 {
-                    httpCtrl->requestState = httpState_requestComplete;                                 // update httpState, got GET/POST response
-                    PRINTF(dbgColor__magenta, "PostRqst dCntxt:%d, status=%d\r", httpCtrl->dataCntxt, httpCtrl->httpStatus);
+                    atcmd_close();
+                    return resultCode__badRequest;
                 }
+                snprintf(sizeHdr, sizeof(sizeHdr), "Content-Length: %lu\r\n", bodySz);
+                httpCtrl->txRqstLine = rqstLine;
+                httpCtrl->txSizeHdr = sizeHdr;
             }
-            else
+            httpCtrl->txRemaining = bodySz;
+            httpCtrl->txChunks = 0;
+
+            uint32_t httpRequestLen = S__requestHdrsSz(httpCtrl) + bodySz;                               // request headers in use + body
+            uint16_t inputTimeSec = httpCtrl->txProducer ? httpCtrl->timeoutSec : http__postInputTimeSec;  // streamed body paced by producer
+
+            atcmd_configDataMode(httpCtrl->dataCntxt, "CONNECT", S__httpRequestTxDataHndlr, workBffr, workBffrSz, NULL, false);
+            atcmd_invokeReuseLock("AT+QHTTPPOST=%lu,%d,%d", httpRequestLen, inputTimeSec, httpCtrl->timeoutSec);
+            rslt = atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(httpCtrl->timeoutSec), S__httpPostStatusParser);
+
+            httpCtrl->txRqstLine = NULL;
+            httpCtrl->txSizeHdr = NULL;
+        }
+
+        if (rslt == resultCode__success && atcmd_getValue() == 0)                                       // "+QHTTPPOST trailer: postErr=0,rslt=200
+        {
+            httpCtrl->httpStatus = S__parseResponseForHttpStatus(httpCtrl, atcmd_getResponse());
+            if (httpCtrl->httpStatus >= resultCode__success && httpCtrl->httpStatus <= resultCode__successMax)
             {
-                httpCtrl->requestState = httpState_idle;
-                httpCtrl->httpStatus = rslt;
-                PRINTF(dbgColor__warn, "Closed failed POST request, status=%d (%s)\r", httpCtrl->httpStatus, atcmd_getErrorDetail());
+                httpCtrl->requestState = httpState_requestComplete;                                     // update httpState, got GET/POST response
+                PRINTF(dbgColor__magenta, "PostRqst dCntxt:%d, status=%d\r", httpCtrl->dataCntxt, httpCtrl->httpStatus);
             }
         }
         else
-            httpCtrl->httpStatus = resultCode__internalError;
+        {
+            httpCtrl->requestState = httpState_idle;
+            httpCtrl->httpStatus = (rslt == resultCode__success) ? atcmd_getValue() : rslt;            // BGx error or command failure
+            PRINTF(dbgColor__warn, "Closed failed POST request, status=%d (%s)\r", httpCtrl->httpStatus, atcmd_getErrorDetail());
+        }
         atcmd_close();
         return httpCtrl->httpStatus;
     }   // awaitLock()
 
     return resultCode__timeout;
-}   /* http_post() */
+}   /* S__httpPost() */
 
 
 
@@ -458,12 +552,182 @@ void http_cancelPage(httpCtrl_t *httpCtrl)
 }
 
 
+/**
+ *	@brief Stores the page results from a previous GET or POST to a BGx file (UFS).
+ *  -----------------------------------------------------------------------------------------------
+ */
+resultCode_t http_readFileResponse(httpCtrl_t *httpCtrl, const char *filename, httpFileProgress_func progressCB)
+{
+    if (httpCtrl->requestState != httpState_requestComplete)
+        return resultCode__preConditionFailed;                                  // readFile() only valid after a completed GET\POST
+
+    /* AT+QHTTPREADFILE=<filename>[,<wait_time>]
+     * BGx responds with OK when the read is started, then with "+QHTTPREADFILE: <err>" URC when the file is complete.
+     * Serviced by S__httpUrcHndlr() while this waits, file size is checked periodically for progress and stall.
+     */
+    if (!atcmd_tryInvoke("AT+QHTTPREADFILE=\"%s\",%d", filename, httpCtrl->timeoutSec))
+        return resultCode__conflict;
+    resultCode_t rslt = atcmd_awaitResult();
+    if (rslt != resultCode__success)
+        return rslt;
+
+    httpCtrl->requestState = httpState_readingFile;
+    httpCtrl->bgxError = 0;
+    uint32_t contentSz = (httpCtrl->pageSize > 0) ? httpCtrl->fileOffset + httpCtrl->pageSize : 0;
+    uint32_t storedSz = 0;
+    uint32_t checkAt = pMillis();
+    uint32_t growthAt = checkAt;
+
+    while (httpCtrl->requestState == httpState_readingFile)
+    {
+        if (pElapsed(checkAt, http__fileProgressIntervalMs))
+        {
+            uint32_t fileSz;
+            if (file_getFileSize(filename, &fileSz) == resultCode__success && fileSz > storedSz)
+            {
+                storedSz = fileSz;
+                growthAt = pMillis();
+                if (progressCB != NULL)
+                    (*progressCB)(httpCtrl->dataCntxt, httpCtrl->fileOffset + storedSz, contentSz);
+            }
+            char *urcPtr = strstr(atcmd_getRawResponse(), "+QHTTPREADFILE: ");                    // completion URC received with QFLST response
+            if (urcPtr != NULL && httpCtrl->requestState == httpState_readingFile)
+                S__httpReadFileDone(httpCtrl, urcPtr);
+            checkAt = pMillis();
+        }
+        if (pElapsed(growthAt, PERIOD_FROM_SECONDS(httpCtrl->timeoutSec) + http__fileProgressIntervalMs))      // BGx wait_time is between packets
+        {
+            httpCtrl->requestState = httpState_idle;
+            PRINTF(dbgColor__warn, "FileResponse stalled at %lu bytes\r", storedSz);
+            return resultCode__timeout;
+        }
+        ltem_eventMgr();                                                        // service completion URC
+        pYield();
+    }
+
+    if (httpCtrl->bgxError != 0)
+    {
+        PRINTF(dbgColor__warn, "FileResponse failed, err=%d\r", httpCtrl->bgxError);
+        return httpCtrl->bgxError;
+    }
+    if (progressCB != NULL && file_getFileSize(filename, &storedSz) == resultCode__success)
+        (*progressCB)(httpCtrl->dataCntxt, httpCtrl->fileOffset + storedSz, contentSz);
+    return resultCode__success;
+}
+
+
+/**
+ *	@brief Perform HTTP GET and store the page content to a BGx file (UFS), resuming with Range requests if interrupted.
+ *  -----------------------------------------------------------------------------------------------
+ */
+resultCode_t http_getFileResponse(httpCtrl_t *httpCtrl, const char *relativeUrl, const char *filename, httpFileProgress_func progressCB, char *workBffr, uint16_t workBffrSz)
+{
+    ASSERT(strlen(filename) + http__filePartSuffixSz < file__filenameSz);
+    ASSERT(workBffr == NULL || workBffrSz > 0);
+
+    httpCtrl->fileOffset = 0;
+    resultCode_t rslt = http_get(httpCtrl, relativeUrl, false);
+    if (rslt != resultCode__success)
+        return rslt;
+
+    uint32_t contentSz = httpCtrl->pageSize;
+    rslt = http_readFileResponse(httpCtrl, filename, progressCB);
+
+    char partFilename[file__filenameSz] = {0};
+    snprintf(partFilename, sizeof(partFilename), "%s.part", filename);
+
+    for (uint8_t attempt = 0; rslt != resultCode__success && attempt < http__fileResumeAttempts; attempt++)
+    {
+        uint32_t fileSz;
+        if (workBffr == NULL || contentSz == 0 || file_getFileSize(filename, &fileSz) != resultCode__success)
+            break;                                                              // resume requires content length, stored file and append buffer
+        if (fileSz >= contentSz)
+        {
+            rslt = resultCode__success;
+            break;
+        }
+
+        httpCtrl->statsFileResumes++;
+        PRINTF(dbgColor__warn, "FileResponse resume at %lu of %lu\r", fileSz, contentSz);
+        rslt = S__httpGet(httpCtrl, relativeUrl, false, fileSz, contentSz - fileSz);
+        if (rslt == resultCode__success)                                        // server ignored Range, restart with full content
+        {
+            httpCtrl->fileOffset = 0;
+            rslt = http_readFileResponse(httpCtrl, filename, progressCB);
+            continue;
+        }
+        if (rslt != http__statusPartialContent)
+            continue;
+
+        httpCtrl->fileOffset = fileSz;
+        rslt = http_readFileResponse(httpCtrl, partFilename, progressCB);
+
+        uint32_t partSz = 0;
+        if (file_getFileSize(partFilename, &partSz) == resultCode__success && partSz > 0)      // keep content of an interrupted part
+        {
+            resultCode_t appendRslt = S__appendFile(filename, partFilename, workBffr, workBffrSz);
+            if (appendRslt != resultCode__success)
+            {
+                rslt = appendRslt;
+                break;
+            }
+            httpCtrl->statsFileResumeBytes += partSz;
+        }
+        file_delete(partFilename);
+    }
+
+    httpCtrl->fileOffset = 0;
+    return rslt;
+}
+
+
+/**
+ *	@brief Perform HTTP POST and store the page content to a BGx file (UFS).
+ *  -----------------------------------------------------------------------------------------------
+ */
+resultCode_t http_postFileResponse(httpCtrl_t *httpCtrl, const char *relativeUrl, const char *postData, uint16_t postDataSz, const char *filename, httpFileProgress_func progressCB)
+{
+    httpCtrl->fileOffset = 0;
+    resultCode_t rslt = http_post(httpCtrl, relativeUrl, false, postData, postDataSz);
+    if (rslt != resultCode__success)
+        return rslt;
+    return http_readFileResponse(httpCtrl, filename, progressCB);
+}
+
+
 #pragma endregion
 
 
 #pragma region Static Functions
 /*-----------------------------------------------------------------------------------------------*/
 
+/**
+ * @brief Get host URL for request, substituting the DNS cache IP address for the host name when allowed.
+ */
+static void S__getHostUrl(httpCtrl_t *httpCtrl, char *hostUrl, uint16_t hostUrlSz)
+{
+    strncpy(hostUrl, httpCtrl->hostUrl, hostUrlSz - 1);
+
+    /* DNS cache substitutes IP address for host name only with custom headers (driver supplies Host header) and without 
+     * TLS (certificate validation requires the host name). Otherwise BGx derives the Host header from the URL.
+     */
+    if (g_lqLTEM.dnsResolver == NULL || httpCtrl->useTls || httpCtrl->cstmHdrs == NULL)
+        return;
+
+    char *hostStart = strstr(httpCtrl->hostUrl, "://");
+    if (hostStart == NULL)
+        return;
+    hostStart += 3;
+    char *hostEnd = hostStart + strcspn(hostStart, ":/");                                       // host name ends at port or path
+
+    char hostName[host__urlSz] = {0};
+    memcpy(hostName, hostStart, MIN(hostEnd - hostStart, sizeof(hostName) - 1));
+    const char *hostAddr = (*g_lqLTEM.dnsResolver)(hostName);
+
+    snprintf(hostUrl, hostUrlSz, "%.*s%s%s", (int)(hostStart - httpCtrl->hostUrl), httpCtrl->hostUrl, hostAddr, hostEnd);
+}
+
+
 /**
  * @brief Helper function to create a URL from host and relative parts.
  */
@@ -471,7 +735,7 @@ static resultCode_t S__setUrl(const char *host, const char *relative)
 {
     uint16_t rslt;
     bool urlSet = false;
-    char url[240] = {0};
+    char url[host__requestUrlSz] = {0};
     
     strcpy(url, host);
     if (strlen(relative) > 0)
@@ -494,10 +758,171 @@ static resultCode_t S__setUrl(const char *host, const char *relative)
         }
     }
     PRINTF(dbgColor__dMagenta, "URL(%d)=\"%s\" \r", strlen(url), url);
-    
+
+    httpCfgState_t *httpCfg = g_lqLTEM.httpCfg;
+    if (strcmp(httpCfg->url, url) == 0)                                                         // BGx holds 1 URL, already set for this request
+    {
+        httpCfg->statsCmdsSkipped++;
+        return resultCode__success;
+    }
+
     atcmd_configDataMode(0, "CONNECT", atcmd_stdTxDataHndlr, url, strlen(url), NULL, true);     // setup for URL dataMode transfer 
     atcmd_invokeReuseLock("AT+QHTTPURL=%d,5", strlen(url));
     rslt = atcmd_awaitResult();
+
+    if (rslt == resultCode__success)
+        strcpy(httpCfg->url, url);
+    else
+        httpCfg->url[0] = '\0';                                                                 // BGx URL state unknown
+    return rslt;
+}
+
+
+/**
+ * @brief Compose custom headers request line and Host header, sent ahead of the custom headers buffer.
+ * @return Length of request line, 0 if it does not fit rqstLine.
+ */
+static uint16_t S__composeRequestLine(httpCtrl_t *httpCtrl, const char *relativeUrl, char *rqstLine, uint16_t rqstLineSz)
+{
+    char *hostName = strchr(httpCtrl->hostUrl, ':');
+    hostName = hostName ? hostName + 3 : httpCtrl->hostUrl;
+
+    int rqstLineLen = snprintf(rqstLine, rqstLineSz, "%s %s HTTP/1.1\r\nHost: %s\r\n", httpCtrl->requestType, relativeUrl, hostName);
+    if (rqstLineLen <= 0 || rqstLineLen >= rqstLineSz)
+    {
+        PRINTF(dbgColor__warn, "Custom request line too long\r");
+        return 0;
+    }
+    PRINTF(dbgColor__dMagenta, "CustomRqst:\r%s%s\r", rqstLine, httpCtrl->cstmHdrs);
+    return rqstLineLen;
+}
+
+
+/**
+ * @brief Length of custom headers request sent ahead of body: request line, custom headers, size header and blank line.
+ */
+static uint32_t S__requestHdrsSz(httpCtrl_t *httpCtrl)
+{
+    if (httpCtrl->txRqstLine == NULL)
+        return 0;
+    return strlen(httpCtrl->txRqstLine) + strlen(httpCtrl->cstmHdrs) + strlen(httpCtrl->txSizeHdr) + 2;
+}
+
+
+/**
+ * @brief Send a BGx HTTP setting (AT+QHTTPCFG) if it differs from the setting last applied.
+ * @param [in] cfgName BGx HTTP setting name
+ * @param [in/out] appliedValue Setting last applied, updated to the value sent or unknown (-1) on failure
+ * @param [in] value Setting required for the request
+ */
+static resultCode_t S__applyCfg(const char *cfgName, int8_t *appliedValue, int8_t value)
+{
+    if (*appliedValue == value)
+    {
+        g_lqLTEM.httpCfg->statsCmdsSkipped++;
+        return resultCode__success;
+    }
+
+    atcmd_invokeReuseLock("AT+QHTTPCFG=\"%s\",%d", cfgName, (int)value);
+    resultCode_t rslt = atcmd_awaitResult();
+    *appliedValue = (rslt == resultCode__success) ? value : -1;
+    return rslt;
+}
+
+
+/**
+ * @brief Set applied BGx HTTP settings to unknown after a BGx start/reset (settings revert to BGx defaults).
+ */
+static void S__validateCfgState()
+{
+    httpCfgState_t *httpCfg = g_lqLTEM.httpCfg;
+    if (!httpCfg->isValid)
+    {
+        httpCfg->responseHdrs = -1;
+        httpCfg->requestHdrs = -1;
+        httpCfg->sslCtxId = -1;
+        httpCfg->url[0] = '\0';
+        httpCfg->isValid = true;
+    }
+}
+
+
+/**
+ * @brief URC handler, completes a file response (http_readFileResponse).
+ */
+static resultCode_t S__httpUrcHndlr()
+{
+    cBuffer_t *rxBffr = g_lqLTEM.iop->rxBffr;                                                   // for convenience
+
+    /* +QHTTPREADFILE: <err>
+     * BGx has one HTTP read at a time, the URC belongs to the stream reading to a file
+     */
+    for (uint8_t cntxt = 0; cntxt < dataCntxt__cnt; cntxt++)
+    {
+        httpCtrl_t *httpCtrl = (httpCtrl_t*)ltem_getStreamFromCntxt(cntxt, streamType_HTTP);
+        if (httpCtrl == NULL || httpCtrl->requestState != httpState_readingFile)
+            continue;
+
+        int16_t urcIndx = cbffr_find(rxBffr, "+QHTTPREADFILE: ", 0, 0, false);
+        if (CBFFR_NOTFOUND(urcIndx))
+            break;
+        if (ATCMD_isLockActive() && urcIndx > 2)                                                // command response (QFLST progress) precedes, left for command
+            break;
+
+        char workBffr[32] = {0};
+        int16_t eolIndx = cbffr_find(rxBffr, "\r\n", urcIndx, sizeof(workBffr) - 3, false);       // leave room for line-end and \0
+        if (CBFFR_FOUND(eolIndx))
+        {
+            cbffr_skipTail(rxBffr, urcIndx);
+            cbffr_pop(rxBffr, workBffr, eolIndx - urcIndx + 2);
+            S__httpReadFileDone(httpCtrl, workBffr);
+        }
+        return resultCode__success;                                                             // serviced, or incomplete and will be on next pass
+    }
+    return resultCode__cancelled;
+}
+
+
+/**
+ * @brief Complete a file response from its URC line: +QHTTPREADFILE: <err>
+ */
+static void S__httpReadFileDone(httpCtrl_t *httpCtrl, const char *urcLine)
+{
+    httpCtrl->bgxError = strtol(urcLine + sizeof("+QHTTPREADFILE: ") - 1, NULL, 10);
+    httpCtrl->requestState = httpState_idle;                                                    // page content consumed
+    PRINTF(dbgColor__cyan, "httpReadFileUrc() cntxt=%d err=%d\r", httpCtrl->dataCntxt, httpCtrl->bgxError);
+}
+
+
+/**
+ * @brief Append content of a BGx file to another, transferred through host buffer.
+ */
+static resultCode_t S__appendFile(const char *destFilename, const char *srcFilename, char *bffr, uint16_t bffrSz)
+{
+    uint16_t srcHandle;
+    uint16_t destHandle;
+
+    resultCode_t rslt = file_open(srcFilename, fileOpenMode_rdOnly, &srcHandle);
+    if (rslt != resultCode__success)
+        return rslt;
+
+    rslt = file_open(destFilename, fileOpenMode_rdWr, &destHandle);
+    if (rslt == resultCode__success)
+    {
+        rslt = file_seek(destHandle, 0, fileSeekMode_fromEnd);
+        uint16_t readCnt = bffrSz;
+        while (rslt == resultCode__success && readCnt == bffrSz)                               // short read is end-of-file
+        {
+            rslt = file_readBuffer(srcHandle, bffr, bffrSz, &readCnt);
+            if (rslt == resultCode__success && readCnt > 0)
+            {
+                fileWriteResult_t writeResult;
+                rslt = file_write(destHandle, bffr, readCnt, &writeResult);
+            }
+        }
+        file_close(destHandle);
+    }
+    file_close(srcHandle);
     return rslt;
 }
 
@@ -544,34 +969,37 @@ static resultCode_t S__httpRxHndlr()
 
     memset(wrkBffr, 0, sizeof(wrkBffr));                                                                // need clean wrkBffr for trailer parsing
     uint32_t readStart = pMillis();
+    bool contentComplete = false;
     do
     {
-        uint16_t occupiedCnt = cbffr_getOccupied(g_lqLTEM.iop->rxBffr);
-        bool readTimeout = pMillis() - readStart > httpCtrl->timeoutSec;
-        uint16_t trailerIndx = cbffr_find(g_lqLTEM.iop->rxBffr, "\r\nOK\r\n\r\n", 0, 0, false);
-        uint16_t reqstBlockSz = MIN(trailerIndx, httpCtrl->defaultBlockSz);
-
-        if (cbffr_getOccupied(g_lqLTEM.iop->rxBffr) >= reqstBlockSz)                                        // sufficient read content ready
+        if (!contentComplete)
         {
-            char* streamPtr;
-            uint16_t blockSz = cbffr_popBlock(g_lqLTEM.iop->rxBffr, &streamPtr, reqstBlockSz);              // get address from rxBffr
-            PRINTF(dbgColor__cyan, "httpPageRcvr() ptr=%p blkSz=%d isFinal=%d\r", streamPtr, blockSz, CBFFR_FOUND(trailerIndx));
+            int16_t trailerIndx = cbffr_find(g_lqLTEM.iop->rxBffr, "\r\nOK\r\n\r\n", 0, 0, false);
+            uint16_t reqstBlockSz = CBFFR_FOUND(trailerIndx) ? MIN(trailerIndx, httpCtrl->defaultBlockSz) : httpCtrl->defaultBlockSz;
 
-            // forward to application
-            ((httpRecv_func)(*httpCtrl->appRecvDataCB))(httpCtrl->dataCntxt, streamPtr, blockSz, CBFFR_FOUND(trailerIndx));
-            cbffr_popBlockFinalize(g_lqLTEM.iop->rxBffr, true);                                             // commit POP
+            if (cbffr_getOccupied(g_lqLTEM.iop->rxBffr) >= reqstBlockSz)                                    // sufficient read content ready
+            {
+                char* streamPtr;
+                uint16_t blockSz = cbffr_popBlock(g_lqLTEM.iop->rxBffr, &streamPtr, reqstBlockSz);          // get address from rxBffr
+                contentComplete = CBFFR_FOUND(trailerIndx) && blockSz == trailerIndx;                       // block wrapping rxBffr end is delivered in 2 parts
+                PRINTF(dbgColor__cyan, "httpPageRcvr() ptr=%p blkSz=%d isFinal=%d\r", streamPtr, blockSz, contentComplete);
+
+                // forward to application
+                ((httpRecv_func)(*httpCtrl->appRecvDataCB))(httpCtrl->dataCntxt, streamPtr, blockSz, contentComplete);
+                cbffr_popBlockFinalize(g_lqLTEM.iop->rxBffr, true);                                         // commit POP
+                readStart = pMillis();
+            }
         }
-
-        if (CBFFR_FOUND(trailerIndx))
+        else
         {
-            // parse trailer for status 
+            // parse trailer for status: \r\nOK\r\n\r\n+QHTTPREAD: <err>\r\n
             uint8_t offset = strlen(wrkBffr);
-            cbffr_pop(g_lqLTEM.iop->rxBffr, wrkBffr + offset, sizeof(wrkBffr) - offset);
+            cbffr_pop(g_lqLTEM.iop->rxBffr, wrkBffr + offset, sizeof(wrkBffr) - offset - 1);
 
-            if (strchr(wrkBffr, '\n'))                                                                      // wait for final /r/n in wrkBffr
+            char* suffix = strstr(wrkBffr, "+QHTTPREAD: ");
+            if (suffix != NULL && strstr(suffix, "\r\n"))                                                   // wait for final /r/n in wrkBffr
             {
-                char* suffix = strstr(wrkBffr, "+QHTTPREAD: ") + sizeof("+QHTTPREAD: ");
-                uint16_t errVal = strtol(suffix, NULL, 10);
+                uint16_t errVal = strtol(suffix + sizeof("+QHTTPREAD: ") - 1, NULL, 10);
                 if (errVal == 0)
                 {
                     return resultCode__success;
@@ -584,9 +1012,85 @@ static resultCode_t S__httpRxHndlr()
                 }
             }
         }
+
+        if (pElapsed(readStart, PERIOD_FROM_SECONDS(httpCtrl->timeoutSec)))                               // page stream stalled (link loss)
+        {
+            PRINTF(dbgColor__warn, "httpPageRcvr() timeout\r");
+            return resultCode__timeout;
+        }
     } while (true);
 }
 
+
+/**
+ * @brief Handles the GET/POST request flow to the BGx (CONNECT data mode): custom request headers, then POST body from RAM or producer
+ */
+static resultCode_t S__httpRequestTxDataHndlr()
+{
+    httpCtrl_t *httpCtrl = (httpCtrl_t*)ltem_getStreamFromCntxt(g_lqLTEM.atcmd->dataMode.contextKey, streamType_HTTP);
+    ASSERT(httpCtrl != NULL);                                                                           // ASSERT data mode and stream context are consistent
+
+    if (httpCtrl->txRqstLine != NULL)                                                                   // custom headers: sent ahead of body
+    {
+        const char *segments[] = { httpCtrl->txRqstLine, httpCtrl->cstmHdrs, httpCtrl->txSizeHdr, "\r\n" };
+        for (size_t i = 0; i < sizeof(segments) / sizeof(segments[0]); i++)
+        {
+            uint16_t segmentSz = strlen(segments[i]);
+            if (segmentSz == 0)
+                continue;
+            IOP_startTx(segments[i], segmentSz);
+            if (!IOP_awaitTxIdle(g_lqLTEM.atcmd->timeout))                                              // IOP starts TX only from idle, segment must remain valid
+                return resultCode__timeout;
+        }
+    }
+
+    if (httpCtrl->txProducer == NULL)                                                                   // body in RAM (http_post)
+    {
+        if (httpCtrl->txRemaining > 0)
+            IOP_startTx(httpCtrl->txBody, httpCtrl->txRemaining);
+        httpCtrl->txRemaining = 0;
+        httpCtrl->txChunks = 1;
+    }
+    else                                                                                                // alternate buffer halves: produce next while sending
+    {
+        uint16_t halfSz = g_lqLTEM.atcmd->dataMode.txDataSz / 2;
+        char *chunkPtr = g_lqLTEM.atcmd->dataMode.txDataLoc;
+        uint16_t chunkSz = (*httpCtrl->txProducer)(httpCtrl->dataCntxt, chunkPtr, MIN(halfSz, httpCtrl->txRemaining));
+
+        while (httpCtrl->txRemaining > 0)
+        {
+            if (chunkSz == 0 || chunkSz > httpCtrl->txRemaining)                                        // producer failed to supply declared body size
+                return resultCode__badRequest;
+
+            IOP_startTx(chunkPtr, chunkSz);
+            httpCtrl->txRemaining -= chunkSz;
+            httpCtrl->txChunks++;
+
+            char *nextPtr = (chunkPtr == g_lqLTEM.atcmd->dataMode.txDataLoc) ? chunkPtr + halfSz : g_lqLTEM.atcmd->dataMode.txDataLoc;
+            uint16_t nextSz = 0;
+            if (httpCtrl->txRemaining > 0)
+                nextSz = (*httpCtrl->txProducer)(httpCtrl->dataCntxt, nextPtr, MIN(halfSz, httpCtrl->txRemaining));
+
+            if (!IOP_awaitTxIdle(g_lqLTEM.atcmd->timeout))
+                return resultCode__timeout;
+            chunkPtr = nextPtr;
+            chunkSz = nextSz;
+        }
+    }
+
+    uint32_t startTime = pMillis();
+    while (pMillis() - startTime < g_lqLTEM.atcmd->timeout)                                            // BGx accepted request
+    {
+        if (CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "OK", 0, 0, true)))
+        {
+            cbffr_skipTail(g_lqLTEM.iop->rxBffr, 4);                                                    // OK + line-end
+            return resultCode__success;
+        }
+        pDelay(1);
+    }
+    return resultCode__timeout;
+}
+
 #pragma endregion
 
 
@@ -608,4 +1112,10 @@ static cmdParseRslt_t S__httpPostStatusParser()
     return atcmd_stdResponseParser("+QHTTPPOST: ", true, ",", 0, 1, "\r\n", 0);
 }
 
+static cmdParseRslt_t S__httpPostFileStatusParser() 
+{
+    // +QHTTPPOSTFILE: <err>[,<httprspcode>[,<content_length>]] 
+    return atcmd_stdResponseParser("+QHTTPPOSTFILE: ", true, ",", 0, 1, "\r\n", 0);
+}
+
 #pragma endregion
\ No newline at end of file
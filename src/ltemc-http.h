@@ -44,7 +44,14 @@ enum http__constants
     http__defaultTimeoutBGxSec = 60,
     http__urlHostSz = 128,
     http__rqstTypeSz = 5,                           /// GET or POST
-    http__customHdrSmallWarning = 40
+    http__customHdrSmallWarning = 40,
+    http__statusPartialContent = 206,               /// server response to a Range request
+    http__fileProgressIntervalMs = 2000,            /// file response: interval file size is checked (stall detection and progress)
+    http__fileResumeAttempts = 3,                   /// file response: Range requests to resume an interrupted download
+    http__filePartSuffixSz = 5,                     /// file response: resumed content is staged in "<filename>.part"
+    http__postInputTimeSec = 5,                     /// POST body in RAM: BGx max time to input body, streamed body uses timeoutSec
+    http__rqstLineSz = host__requestUrlSz + 32,     /// custom headers: "<type> <relativeUrl> HTTP/1.1\r\nHost: <host>\r\n"
+    http__sizeHdrSz = 48                            /// custom headers: Content-Length or Range header line
     // http__reqdResponseSz = 22                    /// BGx HTTP(S) Application Note
 };
 
@@ -60,6 +67,39 @@ enum http__constants
 typedef void (*httpRecv_func)(dataCntxt_t dataCntxt, char *data, uint16_t dataSz, bool isFinal);
 
 
+/** 
+ *  @brief Callback function for file response progress. Invoked periodically while the BGx stores page content to a file.
+ *
+ *  @param [in] dataCntxt [in] Originating data context
+ *  @param [in] fileSz [in] Bytes stored to file
+ *  @param [in] contentSz [in] Page content length, 0 if not reported by server (chunked transfer)
+ */
+typedef void (*httpFileProgress_func)(dataCntxt_t dataCntxt, uint32_t fileSz, uint32_t contentSz);
+
+
+/** 
+ *  @brief Callback function supplying POST body content (http_postStream). Invoked until the declared body size is produced.
+ *
+ *  @param [in] dataCntxt [in] Originating data context
+ *  @param [out] chunkBffr [out] Buffer to fill with next body chunk
+ *  @param [in] chunkBffrSz [in] Max chunk size, never more than remaining body content
+ *  @return Number of chars placed in chunkBffr
+ */
+typedef uint16_t (*httpPostProducer_func)(dataCntxt_t dataCntxt, char *chunkBffr, uint16_t chunkBffrSz);
+
+
+/** 
+ *  @brief Result of a streamed POST (http_postStream).
+*/
+typedef struct httpPostResult_tag
+{
+    uint32_t bytesSent;                         /// body chars sent to BGx
+    uint16_t chunks;                            /// producer chunks
+    uint32_t durationMs;                        /// elapsed time invoke to server result
+    uint32_t throughputBps;                     /// effective throughput (bytes/second)
+} httpPostResult_t;
+
+
 /** 
  *  @brief If using custom headers, bit-map indicating what headers to create for default custom header collection.
 */
@@ -79,6 +119,7 @@ typedef enum httpState_tag
     httpState_idle = 0,
     httpState_requestComplete,
     httpState_readingData,
+    httpState_readingFile,
     httpState_closing
 } httpState_t;
 
@@ -108,6 +149,16 @@ typedef struct httpCtrl_tag
     uint8_t timeoutSec;                         /// default timeout for GET/POST/read requests (BGx is 60 secs)
     uint16_t defaultBlockSz;                    /// default size of block (in of bytes) to transfer to app from page read (page read spans blocks)
     bool pageCancellation;                      /// set to abandon further page loading
+    uint32_t fileOffset;                        /// file response: content stored prior to current read (resume), added to progress
+    uint16_t statsFileResumes;                  /// file response: Range requests issued to resume interrupted downloads
+    uint32_t statsFileResumeBytes;              /// file response: content bytes recovered by resume
+    struct httpDownload_tag *download;          /// range download in progress on this stream (ltemc-httpdownload), page content is routed to it
+    const char *txBody;                         /// POST: body content in RAM (http_post)
+    httpPostProducer_func txProducer;           /// POST: body content source (http_postStream)
+    uint32_t txRemaining;                       /// POST: body chars not yet sent
+    uint16_t txChunks;                          /// POST: body chunks sent
+    const char *txRqstLine;                     /// custom headers: request line and Host header, sent ahead of custom headers
+    const char *txSizeHdr;                      /// custom headers: Content-Length (POST) or Range (GET) header, sent after custom headers
 } httpCtrl_t;
 
 
@@ -179,6 +230,20 @@ void http_addCustomHdr(httpCtrl_t *httpCtrl, const char *hdrText);
 resultCode_t http_get(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs);
 
 
+/**
+ *	@brief Perform HTTP GET operation for a byte range of the resource. Results are internally buffered on the LTEm, see http_readPage().
+ *  @details With custom headers enabled the range is requested with a Range header (recommended, response status and 
+ *           Content-Range are from the server), otherwise with AT+QHTTPGETEX.
+ *  @param [in] httpCtrl Pointer to the control block for HTTP communications.
+ *	@param [in] relativeUrl The URL to GET (starts with \ and doesn't include the host part)
+ *  @param [in] returnResponseHdrs Set to true for page result to include response headers at the start of the page
+ *  @param [in] rangeStart Offset of the first byte requested
+ *  @param [in] rangeSz Number of bytes requested
+ *  @return HTTP status, 206 (http__statusPartialContent) if range was applied by server
+ */
+resultCode_t http_getRange(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs, uint32_t rangeStart, uint32_t rangeSz);
+
+
 /**
  *	@brief Performs a HTTP POST page web request.
  *  @param [in] httpCtrl Pointer to the control block for HTTP communications.
@@ -191,6 +256,35 @@ resultCode_t http_get(httpCtrl_t *httpCtrl, const char* relativeUrl, bool return
 resultCode_t http_post(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs, const char* postData, uint16_t dataSz);
 
 
+/**
+ *	@brief Performs a HTTP POST page web request with the body supplied in chunks by a producer callback.
+ *  @details Body is streamed to the BGx with a fixed working set: workBffr is split into 2 halves, the producer fills one 
+ *           while the other is sent. With custom headers enabled, Content-Length is added from bodySz.
+ *  @param [in] httpCtrl Pointer to the control block for HTTP communications.
+ *	@param [in] relativeUrl URL, relative to the host.
+ *  @param [in] returnResponseHdrs if requested (true) the page response stream will prefix the page data
+ *  @param [in] bodySz Declared body size, producer must supply exactly this many chars
+ *  @param [in] producer Callback supplying body chunks
+ *  @param [in] workBffr Buffer for body chunks (ping-pong halves)
+ *  @param [in] workBffrSz Size of workBffr
+ *  @param [out] postResult Optional (NULL) transfer statistics
+ *  @return HTTP status of the request
+ */
+resultCode_t http_postStream(httpCtrl_t *httpCtrl, const char *relativeUrl, bool returnResponseHdrs, uint32_t bodySz, httpPostProducer_func producer, char *workBffr, uint16_t workBffrSz, httpPostResult_t *postResult);
+
+
+/**
+ *	@brief Performs a HTTP POST page web request with the body read from a BGx file (UFS), body is not transferred from host.
+ *  @details With custom headers enabled the file must hold the complete request: request line, headers and body.
+ *  @param [in] httpCtrl Pointer to the control block for HTTP communications.
+ *	@param [in] relativeUrl URL, relative to the host.
+ *  @param [in] returnResponseHdrs if requested (true) the page response stream will prefix the page data
+ *  @param [in] filename BGx file with POST body
+ *  @return HTTP status of the request
+ */
+resultCode_t http_postFile(httpCtrl_t *httpCtrl, const char *relativeUrl, bool returnResponseHdrs, const char *filename);
+
+
 /**
  *	@brief Retrieves page results from a previous GET or POST.
 
@@ -208,12 +302,51 @@ uint16_t http_readPage(httpCtrl_t *httpCtrl);
 void http_cancelPage(httpCtrl_t *httpCtrl);
 
 
-// future support for fileSystem destinations, requires file_ module still under development planned for v2.1
-/*
-resultCode_t http_getFileResponse(void *httpSession, const char* url, const char* filename);
-resultCode_t http_postFileResponse(void *httpSession, const char* url, const char* filename);
-resultCode_t http_readFileResponse(httpCtrl_t *httpCtrl, char *response, uint16_t responseSz);
-*/
+
+/* ------------------------------------------------------------------------------------------------
+ *  File Response Section: page content is stored to a BGx file (UFS) without passing through host
+ * --------------------------------------------------------------------------------------------- */
+
+/**
+ *	@brief Stores the page results from a previous GET or POST to a BGx file (UFS), replacing any existing file content.
+ *  @details This is a blocking call, returning when the BGx reports the file complete (+QHTTPREADFILE) or stored content
+ *           stops growing for the request timeout.
+ *  @param [in] httpCtrl Pointer to the control block for HTTP communications.
+ *  @param [in] filename BGx file to store page content.
+ *  @param [in] progressCB Optional callback for progress reporting, NULL if not required.
+ *  @return Result code similar to http status code, OK = 200; BGx HTTP error code if read failed
+ */
+resultCode_t http_readFileResponse(httpCtrl_t *httpCtrl, const char *filename, httpFileProgress_func progressCB);
+
+
+/**
+ *	@brief Perform HTTP GET and store the page content to a BGx file (UFS).
+ *  @details If the download is interrupted (link loss) the remaining content is requested with Range requests and appended
+ *           to the file. Resume requires a server reported content length; the resumed part is staged in a BGx file
+ *           ("<filename>.part") and appended to the file with workBffr.
+ *  @param [in] httpCtrl Pointer to the control block for HTTP communications.
+ *	@param [in] relativeUrl The URL to GET (starts with \ and doesn't include the host part)
+ *  @param [in] filename BGx file to store page content.
+ *  @param [in] progressCB Optional callback for progress reporting, NULL if not required.
+ *  @param [in] workBffr Buffer to append resumed content, NULL to disable resume.
+ *  @param [in] workBffrSz Size of workBffr.
+ *  @return Result code similar to http status code, OK = 200
+ */
+resultCode_t http_getFileResponse(httpCtrl_t *httpCtrl, const char *relativeUrl, const char *filename, httpFileProgress_func progressCB, char *workBffr, uint16_t workBffrSz);
+
+
+/**
+ *	@brief Perform HTTP POST and store the page content to a BGx file (UFS). POST is not resumed.
+ *  @param [in] httpCtrl Pointer to the control block for HTTP communications.
+ *	@param [in] relativeUrl URL, relative to the host.
+ *  @param [in] postData Pointer to char buffer with POST content
+ *  @param [in] postDataSz Size of the POST content reference by *postData
+ *  @param [in] filename BGx file to store page content.
+ *  @param [in] progressCB Optional callback for progress reporting, NULL if not required.
+ *  @return Result code similar to http status code, OK = 200
+ */
+resultCode_t http_postFileResponse(httpCtrl_t *httpCtrl, const char *relativeUrl, const char *postData, uint16_t postDataSz, const char *filename, httpFileProgress_func progressCB);
+
 
 #ifdef __cplusplus
 }
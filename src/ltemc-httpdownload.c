@@ -0,0 +1,266 @@
+/** ****************************************************************************
+  \file
+  \brief HTTP resource download in verified byte ranges with checkpoint and retry
+  \author Greg Terrell, LooUQ Incorporated
+
+  \loouq
+
+--------------------------------------------------------------------------------
+
+    This project is released under the GPL-3.0 License.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+#define _DEBUG 0                        // set to non-zero value for PRINTF debugging output,
+// debugging output options             // LTEm1c will satisfy PRINTF references with empty definition if not already resolved
+#if _DEBUG > 0
+    asm(".global _printf_float");       // forces build to link in float support for printf
+    #if _DEBUG == 1
+    #define SERIAL_DBG 1                // enable serial port output using devl host platform serial, 1=wait for port
+    #elif _DEBUG == 2
+    #include <jlinkRtt.h>               // output debug PRINTF macros to J-Link RTT channel
+    #define PRINTF(c_,f_,__VA_ARGS__...) do { rtt_printf(c_, (f_), ## __VA_ARGS__); } while(0)
+    #endif
+#else
+#define PRINTF(c_, f_, ...)
+#endif
+
+
+#define SRCFILE "HDL"                           // create SRCFILE (3 char) MACRO for lq-diagnostics ASSERT
+#include "ltemc-internal.h"
+#include "ltemc-httpdownload.h"
+#include <ctype.h>
+
+extern ltemDevice_t g_lqLTEM;
+
+#define MIN(x, y) (((x) < (y)) ? (x) : (y))
+
+
+// file scope local function declarations
+static resultCode_t S__downloadRange(httpDownload_t *download);
+static void S__downloadRecv(dataCntxt_t dataCntxt, char *data, uint16_t dataSz, bool isFinal);
+static void S__downloadParseHeader(httpDownload_t *download, const char *hdrLine);
+
+
+
+#pragma region public HTTP download functions
+/* --------------------------------------------------------------------------------------------- */
+
+
+/**
+ *	@brief Initialize a range download.
+ */
+void httpDownload_init(httpDownload_t *download, httpCtrl_t *httpCtrl, const char *relativeUrl, httpDownloadRecv_func appRecvCB, uint32_t rangeSz, uint32_t checkpoint)
+{
+    ASSERT(httpCtrl != NULL && appRecvCB != NULL);
+
+    memset(download, 0, sizeof(httpDownload_t));
+    download->httpCtrl = httpCtrl;
+    download->relativeUrl = relativeUrl;
+    download->appRecvCB = appRecvCB;
+    download->rangeSz = (rangeSz > 0) ? rangeSz : httpDownload__defaultRangeSz;
+    download->maxRetries = httpDownload__defaultMaxRetries;
+    download->checkpoint = checkpoint;
+}
+
+
+/**
+ *	@brief Download the resource from the checkpoint to the end, range by range.
+ */
+resultCode_t httpDownload_run(httpDownload_t *download)
+{
+    httpCtrl_t *httpCtrl = download->httpCtrl;
+    ASSERT(httpCtrl->cstmHdrs != NULL);                                             // Range is requested as custom header
+
+    appRcvProto_func appRecvDataCB = httpCtrl->appRecvDataCB;                       // page content is routed to download during run
+    httpCtrl->appRecvDataCB = (appRcvProto_func)S__downloadRecv;
+    httpCtrl->download = download;
+
+    uint32_t runStart = pMillis();
+    uint32_t runBytes = download->statsBytes;
+    uint8_t attempts = 0;
+    resultCode_t rslt = resultCode__success;
+
+    while (download->resourceSz == 0 || download->checkpoint < download->resourceSz)
+    {
+        rslt = S__downloadRange(download);
+        if (rslt == resultCode__success)
+        {
+            download->statsRanges++;
+            attempts = 0;
+            continue;
+        }
+        if (rslt == resultCode__preConditionFailed || ++attempts > download->maxRetries)    // range not supported by server is not retried
+            break;
+        download->statsRetries++;
+        PRINTF(dbgColor__warn, "httpDownload retry at %lu, rslt=%d\r", download->checkpoint, rslt);
+    }
+
+    httpCtrl->appRecvDataCB = appRecvDataCB;
+    httpCtrl->download = NULL;
+
+    download->statsDurationMs = pMillis() - runStart;
+    runBytes = download->statsBytes - runBytes;
+    download->statsThroughputBps = (download->statsDurationMs > 0) ? (uint32_t)(((uint64_t)runBytes * 1000) / download->statsDurationMs) : 0;
+    PRINTF(dbgColor__dYellow, "httpDownload rslt=%d bytes=%lu refetched=%lu %lu B/s\r", rslt, runBytes, download->statsRefetchedBytes, download->statsThroughputBps);
+    return rslt;
+}
+
+
+/**
+ *	@brief Get download progress.
+ */
+uint8_t httpDownload_getProgress(httpDownload_t *download)
+{
+    if (download->resourceSz == 0)
+        return 0;
+    return (uint8_t)(((uint64_t)download->checkpoint * 100) / download->resourceSz);
+}
+
+
+#pragma endregion
+
+
+#pragma region Static Local Functions
+/* --------------------------------------------------------------------------------------------- */
+
+
+/**
+ *	@brief Request and read one range, from the checkpoint.
+ */
+static resultCode_t S__downloadRange(httpDownload_t *download)
+{
+    uint32_t rangeStart = download->checkpoint;
+    uint32_t rangeSz = download->rangeSz;
+    if (download->resourceSz > 0)
+        rangeSz = MIN(rangeSz, download->resourceSz - rangeStart);
+
+    download->rangeOffset = rangeStart;
+    download->rangeEnd = 0;
+    download->rangeVerified = false;
+    download->rangeError = false;
+    download->headersComplete = false;
+    download->hdrLineSz = 0;
+
+    resultCode_t rslt = http_getRange(download->httpCtrl, download->relativeUrl, true, rangeStart, rangeSz);
+    if (rslt == resultCode__success)                                                // 200: server ignored Range
+        return resultCode__preConditionFailed;
+    if (rslt != http__statusPartialContent)
+        return rslt;
+
+    rslt = http_readPage(download->httpCtrl);                                       // content streamed to S__downloadRecv()
+    if (rslt != resultCode__success)
+        return rslt;
+    if (!download->rangeVerified || download->rangeError)
+        return resultCode__conflict;                                                // Content-Range missing or inconsistent with request
+    if (download->checkpoint < download->rangeEnd)
+        return resultCode__unavailable;                                             // response ended short of Content-Range
+    return resultCode__success;
+}
+
+
+/**
+ *	@brief Page receiver during download: parses response headers, delivers content after checkpoint to application.
+ */
+static void S__downloadRecv(dataCntxt_t dataCntxt, char *data, uint16_t dataSz, bool isFinal)
+{
+    httpCtrl_t *httpCtrl = (httpCtrl_t*)ltem_getStreamFromCntxt(dataCntxt, streamType_HTTP);
+    ASSERT(httpCtrl != NULL && httpCtrl->download != NULL);
+    httpDownload_t *download = httpCtrl->download;
+
+    /* response headers precede content, lines may span blocks
+     */
+    while (dataSz > 0 && !download->headersComplete)
+    {
+        char hdrChar = *data++;
+        dataSz--;
+        if (hdrChar == '\n')
+        {
+            download->hdrLine[download->hdrLineSz] = '\0';
+            if (download->hdrLineSz == 0)                                           // blank line ends headers
+            {
+                download->headersComplete = true;
+                download->rangeError |= !download->rangeVerified;
+            }
+            else
+                S__downloadParseHeader(download, download->hdrLine);
+            download->hdrLineSz = 0;
+        }
+        else if (hdrChar != '\r' && download->hdrLineSz < sizeof(download->hdrLine) - 1)
+        {
+            download->hdrLine[download->hdrLineSz++] = hdrChar;
+        }
+    }
+    if (dataSz == 0 || download->rangeError)
+        return;
+
+    if (download->rangeOffset < download->checkpoint)                               // content already delivered
+    {
+        uint16_t skipSz = MIN(dataSz, download->checkpoint - download->rangeOffset);
+        download->statsRefetchedBytes += skipSz;
+        download->rangeOffset += skipSz;
+        data += skipSz;
+        dataSz -= skipSz;
+    }
+    if (dataSz > 0)
+    {
+        (*download->appRecvCB)(httpCtrl->dataCntxt, download->rangeOffset, data, dataSz);
+        download->rangeOffset += dataSz;
+        download->checkpoint = download->rangeOffset;
+        download->statsBytes += dataSz;
+    }
+}
+
+
+/**
+ *	@brief Parse a response header line, verifies Content-Range against the request and resource size.
+ */
+static void S__downloadParseHeader(httpDownload_t *download, const char *hdrLine)
+{
+    const char *hdrName = "content-range:";
+    for (uint8_t i = 0; hdrName[i] != '\0'; i++)
+    {
+        if (tolower(hdrLine[i]) != hdrName[i])                                      // header names are case-insensitive
+            return;
+    }
+
+    // Content-Range: bytes <first>-<last>/<complete-length>
+    char *workPtr = strstr(hdrLine, "bytes ");
+    if (workPtr == NULL)
+    {
+        download->rangeError = true;
+        return;
+    }
+    uint32_t first = strtoul(workPtr + 6, &workPtr, 10);
+    uint32_t last = (*workPtr == '-') ? strtoul(workPtr + 1, &workPtr, 10) : 0;
+    uint32_t total = (*workPtr == '/') ? strtoul(workPtr + 1, NULL, 10) : 0;        // "*" (unknown) is not supported
+
+    if (last < first || last >= total || first > download->checkpoint ||
+        (download->resourceSz > 0 && total != download->resourceSz))
+    {
+        PRINTF(dbgColor__warn, "httpDownload Content-Range mismatch: %s\r", hdrLine);
+        download->rangeError = true;
+        return;
+    }
+    download->resourceSz = total;
+    download->rangeOffset = first;
+    download->rangeEnd = last + 1;
+    download->rangeVerified = true;
+}
+
+
+#pragma endregion
@@ -0,0 +1,132 @@
+/** ****************************************************************************
+  \file
+  \author Greg Terrell, LooUQ Incorporated
+
+  \loouq
+
+--------------------------------------------------------------------------------
+
+    This project is released under the GPL-3.0 License.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+
+#ifndef __LTEMC_HTTPDOWNLOAD_H__
+#define __LTEMC_HTTPDOWNLOAD_H__
+
+#include <lq-types.h>
+#include "ltemc-types.h"
+#include "ltemc-http.h"
+
+
+/**
+ *  @brief Typed numeric constants for HTTP range download
+ */
+enum httpDownload__constants
+{
+    httpDownload__defaultRangeSz = 16384,       /// bytes requested per range
+    httpDownload__defaultMaxRetries = 3,        /// consecutive failed attempts of a range before download is abandoned
+    httpDownload__hdrLineSz = 80                /// response header line buffer, longer lines are truncated (not parsed)
+};
+
+
+/** 
+ *  @brief Callback function for download content. Content is delivered in order, each byte once.
+ *
+ *  @param [in] dataCntxt [in] Originating data context
+ *  @param [in] offset [in] Resource offset of data
+ *  @param [in] data [in] Pointer to content
+ *  @param [in] dataSz [in] The number of bytes available
+ */
+typedef void (*httpDownloadRecv_func)(dataCntxt_t dataCntxt, uint32_t offset, const char *data, uint16_t dataSz);
+
+
+/**
+ *  @brief HTTP resource download in byte ranges (Range request header, verified with response Content-Range).
+ *  @details checkpoint is the count of resource bytes delivered to the application; a failed range is retried from the 
+ *           checkpoint. An application persisting the checkpoint can continue a download after restart (httpDownload_init).
+*/
+typedef struct httpDownload_tag
+{
+    httpCtrl_t *httpCtrl;                       /// HTTP stream, custom headers enabled (Range header)
+    const char *relativeUrl;                    /// resource URL, relative to host
+    httpDownloadRecv_func appRecvCB;            /// application content receiver
+    uint32_t rangeSz;                           /// bytes requested per range
+    uint8_t maxRetries;                         /// consecutive failed attempts of a range before download is abandoned
+    uint32_t resourceSz;                        /// resource size from Content-Range, 0 until first range response
+    uint32_t checkpoint;                        /// resource bytes delivered, next range starts here
+
+    /* current range response parsing */
+    uint32_t rangeOffset;                       /// resource offset of next content byte in response (Content-Range start)
+    uint32_t rangeEnd;                          /// resource offset following last content byte of response (Content-Range end + 1)
+    bool rangeVerified;                         /// Content-Range parsed and consistent with request
+    bool rangeError;                            /// Content-Range missing or inconsistent, range content discarded
+    bool headersComplete;
+    char hdrLine[httpDownload__hdrLineSz];
+    uint8_t hdrLineSz;
+
+    uint32_t statsBytes;                        /// content bytes delivered to application
+    uint32_t statsRefetchedBytes;               /// content bytes received more than once (before checkpoint), discarded
+    uint16_t statsRanges;                       /// range requests completed
+    uint16_t statsRetries;                      /// range requests failed and retried
+    uint32_t statsDurationMs;                   /// duration of last httpDownload_run()
+    uint32_t statsThroughputBps;                /// effective throughput of last httpDownload_run(), delivered bytes/sec
+} httpDownload_t;
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+
+/**
+ *	@brief Initialize a range download.
+ *  @param download [out] Pointer to download structure
+ *  @param httpCtrl [in] HTTP stream to download with, requires custom headers enabled (http_enableCustomHdrs)
+ *  @param relativeUrl [in] Resource URL, relative to host (must remain valid during download)
+ *  @param appRecvCB [in] Application content receiver
+ *  @param rangeSz [in] Bytes per range request, 0 = httpDownload__defaultRangeSz
+ *  @param checkpoint [in] Resource offset to start at, 0 for new download or a previously saved checkpoint to continue
+ */
+void httpDownload_init(httpDownload_t *download, httpCtrl_t *httpCtrl, const char *relativeUrl, httpDownloadRecv_func appRecvCB, uint32_t rangeSz, uint32_t checkpoint);
+
+
+/**
+ *	@brief Download the resource from the checkpoint to the end, range by range. This is a blocking call.
+ *  @details A failed range (request error, link loss, Content-Range mismatch) is requested again from the checkpoint,
+ *           up to maxRetries consecutive attempts.
+ *  @param download [in] Pointer to download structure
+ *  @return Result code similar to http status code, OK = 200 (resource complete); preConditionFailed if server does not
+ *          support range requests
+ */
+resultCode_t httpDownload_run(httpDownload_t *download);
+
+
+/**
+ *	@brief Get download progress.
+ *  @param download [in] Pointer to download structure
+ *  @return Percent complete (0-100), 0 if resource size is not yet known
+ */
+uint8_t httpDownload_getProgress(httpDownload_t *download);
+
+
+#ifdef __cplusplus
+}
+#endif // !__cplusplus
+
+#endif  /* !__LTEMC_HTTPDOWNLOAD_H__ */
@@ -84,9 +84,27 @@ typedef struct fileCtrl_tag
     uint8_t handle;
     dataRxHndlr_func dataRxHndlr;               /// function to handle data streaming, initiated by atcmd dataMode (RX only)
     appRcvProto_func appRecvDataCB;
+    char *readBffr;                             /// file_readBuffer(): read destination, NULL = forward to appRecvDataCB
+    uint16_t readBffrSz;
+    uint16_t readCnt;
 } fileCtrl_t;
 
 
+/**
+ *  \brief BGx HTTP settings last applied. The BGx holds one HTTP configuration (and URL) for all HTTP streams, requests only
+ *  send settings that differ. Invalidated on modem reset/start.
+ */
+typedef struct httpCfgState_tag
+{
+    bool isValid;                               /// false = BGx settings unknown (reset), re-applied on next request
+    int8_t responseHdrs;                        /// AT+QHTTPCFG="responseheader", -1 = unknown
+    int8_t requestHdrs;                         /// AT+QHTTPCFG="requestheader", -1 = unknown
+    int8_t sslCtxId;                            /// AT+QHTTPCFG="sslctxid", -1 = unknown
+    char url[host__requestUrlSz];               /// AT+QHTTPURL, empty = unknown
+    uint32_t statsCmdsSkipped;                  /// config/URL commands not sent, setting already applied
+} httpCfgState_t;
+
+
  /** 
  *  \brief Struct representing the LTEmC model. The struct behind the g_ltem1 global variable with all driver controls.
  * 
@@ -97,6 +115,7 @@ typedef struct ltemDevice_tag
 	ltemPinConfig_t pinConfig;                  /// GPIO pin configuration for required GPIO and SPI interfacing
     bool cancellationRequest;                   /// For RTOS implementations, token to request cancellation of long running task/action
     deviceState_t deviceState;                  /// Device state of the BGx module
+    bool transparentMode;                       /// UART is carrying raw socket data (transparent access mode), no AT command or URC traffic
     appEvntNotify_func appEvntNotifyCB;         /// Event notification callback to parent application
     char moduleType[ltem__moduleTypeSz];        /// c-str indicating module type. BG96, BG95-M3, BG77, etc. (so far)
     void *spi;                                  /// SPI device (methods signatures compatible with Arduino)
@@ -107,6 +126,10 @@ typedef struct ltemDevice_tag
     providerInfo_t *providerInfo;               /// Data structure representing the cellular network provider and the networks (PDP contexts it provides)
     streamCtrl_t* streams[ltem__streamCnt];     /// Data streams: protocols or file system
     fileCtrl_t* fileCtrl;
+    httpCfgState_t *httpCfg;                    /// BGx HTTP settings last applied (optional, created by http_initControl())
+    doWork_func doWorkers[ltem__doWorkersCnt];  /// Module background workers, invoked by ltem_eventMgr()
+    struct dnsCache_tag *dnsCache;              /// DNS cache (optional, created by dns_create())
+    dnsResolver_func dnsResolver;               /// Host name resolver used by stream opens, NULL = BGx resolves host name on open
 
     ltemMetrics_t metrics;                      /// metrics for operational analysis and reporting
 } ltemDevice_t;
@@ -131,9 +154,16 @@ extern "C"
 
 // LTEM Internal
 // void LTEM_initIo();
-// void LTEM_registerDoWorker(doWork_func *doWorker);
 // void LTEM_registerUrcHandler(urcHandler_func *urcHandler);
 
+/**
+ *  \brief Register a module background worker, invoked on each pass of ltem_eventMgr().
+ *  \details Workers are invoked whether or not an AT command is underway; a worker MUST check ATCMD_isLockActive() 
+ *           before invoking any AT command. Registering the same worker more than once is ignored.
+ *  \param doWorker [in] Module worker function.
+ */
+void LTEM_registerDoWorker(doWork_func doWorker);
+
 #pragma region ATCMD LTEmC Internal Functions
 /* LTEmC internal, not intended for user application consumption.
  * --------------------------------------------------------------------------------------------- */
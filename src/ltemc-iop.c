@@ -218,6 +218,22 @@ void IOP_startTx(const char *sendData, uint16_t sendSz)
 }
 
 
+/**
+ *	@brief Wait for TX to complete; all pending chars are sent and the UART bridge TX FIFO is empty.
+ */
+bool IOP_awaitTxIdle(uint32_t timeoutMS)
+{
+    uint32_t waitStart = pMillis();
+    while (g_lqLTEM.iop->txPending > 0 || SC16IS7xx_readReg(SC16IS7xx_TXLVL_regAddr) < SC16IS7xx__FIFO_bufferSz)
+    {
+        if (pElapsed(waitStart, timeoutMS))
+            return false;
+        pYield();
+    }
+    return true;
+}
+
+
 /**
  *	@brief Perform a forced TX send immediate operation. Intended for sending break type events to device.
  */
@@ -74,6 +74,14 @@ bool IOP_awaitAppReady();
 void IOP_startTx(const char *sendData, uint16_t sendSz);
 
 
+/**
+ *	@brief Wait for TX to complete; all pending chars are sent and the UART bridge TX FIFO is empty.
+ *  @param timeoutMS [in] Maximum time to wait in milliseconds.
+ *  @return True if TX is idle, false on timeout.
+ */
+bool IOP_awaitTxIdle(uint32_t timeoutMS);
+
+
 /**
  *	@brief Perform a forced TX send immediate operation. Intended for sending break type events to device.
  *  @details sendData must be less than 64 chars. This function aborts any TX and immediately posts data to UART.
@@ -42,6 +42,7 @@
 #define SRCFILE "MQT"                           // create SRCFILE (3 char) MACRO for lq-diagnostics ASSERT
 #include "ltemc-internal.h"
 #include "ltemc-mqtt.h"
+#include "ltemc-sckt.h"
 
 extern ltemDevice_t g_lqLTEM;
 
@@ -65,9 +66,26 @@ enum
 /* Local Function Declarations
  ----------------------------------------------------------------------------------------------- */
 
-static uint8_t S__findtopicIndx(mqttCtrl_t* mqttCntl, mqttTopicCtrl_t* topicCtrl);
+static bool S__topicInsert(mqttCtrl_t *mqttCtrl, mqttTopicCtrl_t *topicCtrl);
+static bool S__topicRemove(mqttCtrl_t *mqttCtrl, mqttTopicNode_t **nodeLink, const char *filter, mqttTopicCtrl_t *topicCtrl);
+static mqttTopicCtrl_t* S__topicMatch(cBuffer_t *rxBffr, mqttTopicNode_t *node, uint16_t topicLen, uint16_t levelStart, uint16_t *prefixLen);
+static void S__mqttDeliverSegment(cBuffer_t *rxBffr, mqttTopicCtrl_t *topicCtrl, dataCntxt_t dataCntxt, uint16_t msgId, mqttMsgSegment_t segment, uint16_t segmentSz);
+static resultCode_t S__topicResubscribe(mqttCtrl_t *mqttCtrl, mqttTopicNode_t *node);
 static resultCode_t S__notifyServerTopicChange(mqttCtrl_t* mqttCtrl, mqttTopicCtrl_t* topicCtrl, bool subscribe);
-static void S__mqttUrcHandler();
+static resultCode_t S__mqttUrcHandler();
+static bool S__mqttPublishUrc(cBuffer_t *rxBffr);
+static bool S__mqttIsInflightAck(cBuffer_t *rxBffr, uint16_t urcIndx);
+static void S__mqttPublishAck(const char *ackLine);
+static void S__mqttPublishComplete(mqttCtrl_t *mqttCtrl, mqttInflight_t *inflight, mqttResult_t result);
+static void S__mqttExpireInflight(mqttCtrl_t *mqttCtrl);
+static bool S__mqttRecvSignalUrc(mqttCtrl_t *mqttCtrl, cBuffer_t *rxBffr);
+static bool S__mqttStreamMessage(cBuffer_t *rxBffr);
+static resultCode_t S__mqttRecvDataHndlr();
+static uint8_t S__bitCount(uint8_t bitmap);
+static void S__mqttDoWork();
+static void S__mqttRecover(mqttCtrl_t *mqttCtrl);
+static resultCode_t S__mqttRecoverAttempt(mqttCtrl_t *mqttCtrl);
+static void S__mqttModemResetStreams();
 
 //static cmdParseRslt_t S__mqttOpenStatusParser();
 static cmdParseRslt_t S__mqttOpenCompleteParser();
@@ -75,6 +93,9 @@ static cmdParseRslt_t S__mqttConnectCompleteParser();
 static cmdParseRslt_t S__mqttConnectStatusParser();
 static cmdParseRslt_t S__mqttSubscribeCompleteParser();
 static cmdParseRslt_t S__mqttPublishCompleteParser();
+static cmdParseRslt_t S__mqttPublishExCompleteParser();
+static bool S__mqttPublishInlineEligible(const char *topic, const char *message, uint16_t messageSz);
+static resultCode_t S__mqttProducerTxDataHndlr();
 
 
 /* public mqtt functions
@@ -93,11 +114,29 @@ void mqtt_initControl(mqttCtrl_t *mqttCtrl, dataCntxt_t dataCntxt)
     memset(mqttCtrl, 0, sizeof(mqttCtrl_t));
 
     mqttCtrl->streamType = streamType_MQTT;
+    mqttCtrl->dataCntxt = dataCntxt;
+    mqttCtrl->inflightWindow = mqtt__inflightCnt;
     mqttCtrl->urcEvntHndlr = S__mqttUrcHandler;                 // for MQTT, URC handler performs all necessary functions
     mqttCtrl->dataRxHndlr = NULL;                               // marshalls data from buffer to app done by URC handler
 }
 
 
+/**
+ *  @brief Supply the node pool for the subscription topic trie.
+*/
+void mqtt_setTopicPool(mqttCtrl_t *mqttCtrl, mqttTopicNode_t *topicNodes, uint16_t nodeCnt)
+{
+    ASSERT(mqttCtrl->topicRoot == NULL);                        // pool change not supported with subscriptions
+
+    memset(topicNodes, 0, nodeCnt * sizeof(mqttTopicNode_t));
+    for (uint16_t i = 0; i + 1 < nodeCnt; i++)                  // chain nodes into free list
+    {
+        topicNodes[i].sibling = &topicNodes[i + 1];
+    }
+    mqttCtrl->topicFree = (nodeCnt > 0) ? topicNodes : NULL;
+}
+
+
 /**
  *  @brief Initialize a MQTT topic subscription control structure.
 */
@@ -106,16 +145,20 @@ void mqtt_initTopicControl(mqttTopicCtrl_t* topicCtrl, const char* topic, uint8_
     memset(topicCtrl, 0, sizeof(mqttTopicCtrl_t));
 
     uint16_t topicLen = strlen(topic);
+    ASSERT(topicLen > 0 && topicLen < mqtt__topic_nameSz);
+
     if (topic[topicLen - 1] == '#')
     {
         topicCtrl->wildcard = '#';
-        topicLen -= 2;
+    }
+    else if (strchr(topic, '+') != NULL)
+    {
+        topicCtrl->wildcard = '+';
     }
     else
     {
         topicCtrl->wildcard = '\0';
     }
-    ASSERT(topicLen < mqtt__topic_nameSz);
 
     memcpy(topicCtrl->topicName, topic, topicLen);
     topicCtrl->Qos = qos;
@@ -174,9 +217,21 @@ resultCode_t mqtt_open(mqttCtrl_t *mqttCtrl)
         if (atcmd_awaitResult() != resultCode__success)
             return resultCode__internalError;
     }
+    // AT+QMTCFG="recv/mode",0,<msg_recv_mode>,<msg_len_enable>: 0=message in URC, 1=message held at BGx, URC signals buffer slot
+    // msg_len_enable=1: payload length reported, message receive is length framed (binary safe)
+    if (atcmd_tryInvoke("AT+QMTCFG=\"recv/mode\",%d,%d,1", mqttCtrl->dataCntxt, mqttCtrl->recvBuffered))
+    {
+        if (atcmd_awaitResult() != resultCode__success)
+            return resultCode__internalError;
+    }
 
     // TYPICAL: AT+QMTOPEN=0,"iothub-dev-pelogical.azure-devices.net",8883
-    if (atcmd_tryInvoke("AT+QMTOPEN=%d,\"%s\",%d", mqttCtrl->dataCntxt, mqttCtrl->hostUrl, mqttCtrl->hostPort))
+    const char *hostAddr = mqttCtrl->hostUrl;
+    if (g_lqLTEM.dnsResolver != NULL && !mqttCtrl->useTls)                     // DNS cache enabled, TLS requires host name for certificate validation
+    {
+        hostAddr = (*g_lqLTEM.dnsResolver)(mqttCtrl->hostUrl);
+    }
+    if (atcmd_tryInvoke("AT+QMTOPEN=%d,\"%s\",%d", mqttCtrl->dataCntxt, hostAddr, mqttCtrl->hostPort))
     {
         resultCode_t rslt = atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(45), S__mqttOpenCompleteParser);
         if (rslt == resultCode__success && atcmd_getValue() == 0)
@@ -228,6 +283,7 @@ resultCode_t mqtt_connect(mqttCtrl_t *mqttCtrl, bool cleanSession)
         switch (atcmd_getValue())
         {
             case 0:
+                mqttCtrl->state = mqttState_connected;
                 return resultCode__success;
             case 1:
                 return resultCode__methodNotAllowed;                    // invalid protocol version 
@@ -254,7 +310,8 @@ resultCode_t mqtt_start(mqttCtrl_t *mqttCtrl, bool cleanSession)
 
     do
     {
-        ltem_addStream(mqttCtrl);                                       // register stream for background receive operations (URC)
+        if (ltem_getStreamFromCntxt(mqttCtrl->dataCntxt, streamType_MQTT) == NULL)     // mqtt_reset() restarts a registered stream
+            ltem_addStream(mqttCtrl);                                   // register stream for background receive operations (URC)
 
         rslt = mqtt_open(mqttCtrl);
         if (rslt != resultCode__success)
@@ -263,25 +320,20 @@ resultCode_t mqtt_start(mqttCtrl_t *mqttCtrl, bool cleanSession)
             break;
         }
 
-        rslt = mqtt_connect(mqttCtrl, true);
+        rslt = mqtt_connect(mqttCtrl, cleanSession);
         if (rslt != resultCode__success)
         {
             PRINTF(dbgColor__warn, "Connect fail status=%d\r", rslt);
             break;
         }
 
-        for (size_t i = 0; i < mqtt__topicsCnt; i++)
+        rslt = S__topicResubscribe(mqttCtrl, mqttCtrl->topicRoot);     // (re)subscribe all topics in trie
+        if (rslt != resultCode__success)
         {
-            if (mqttCtrl->topics[i] != NULL)
-            {
-                rslt = S__notifyServerTopicChange(mqttCtrl, mqttCtrl->topics[i], true);
-                if (rslt != resultCode__success)
-                {
-                    return rslt;
-                }
-                break;
-            }
+            PRINTF(dbgColor__warn, "Subscribe fail status=%d\r", rslt);
+            break;
         }
+        mqttCtrl->sessionPersisted = !cleanSession;
         PRINTF(dbgColor__green, "MQTT Started\r");
     } while (false);
 
@@ -290,25 +342,21 @@ resultCode_t mqtt_start(mqttCtrl_t *mqttCtrl, bool cleanSession)
 
 
 /**
- *  @brief Open and connect to a remote MQTT server.
+ *  @brief Subscribe to a topic on the MQTT server.
  */
 resultCode_t mqtt_subscribeTopic(mqttCtrl_t *mqttCtrl, mqttTopicCtrl_t* topicCtrl)
 {
-    uint8_t topicIndx = S__findtopicIndx(mqttCtrl, topicCtrl);
-    if (topicIndx != 255)
-    {
-        mqttCtrl->topics[topicIndx] = topicCtrl;
-    }
-    else
+    if (!S__topicInsert(mqttCtrl, topicCtrl))
     {
-        return resultCode__preConditionFailed;
+        S__topicRemove(mqttCtrl, &mqttCtrl->topicRoot, topicCtrl->topicName, topicCtrl);      // release partially inserted levels
+        return resultCode__preConditionFailed;                                                  // topic node pool exhausted
     }
     
     if (mqttCtrl->state == mqttState_connected)
     {
-        S__notifyServerTopicChange(mqttCtrl, mqttCtrl->topics[topicIndx], true);
+        return S__notifyServerTopicChange(mqttCtrl, topicCtrl, true);
     }
-    return resultCode__conflict;
+    return resultCode__success;                                                                 // subscribed to server at mqtt_start()
 }
 
 
@@ -317,21 +365,16 @@ resultCode_t mqtt_subscribeTopic(mqttCtrl_t *mqttCtrl, mqttTopicCtrl_t* topicCtr
  */
 resultCode_t mqtt_cancelTopic(mqttCtrl_t *mqttCtrl, mqttTopicCtrl_t* topicCtrl)
 {
-    uint8_t topicIndx = S__findtopicIndx(mqttCtrl, topicCtrl);
-    if (topicIndx != 255)
-    {
-        mqttCtrl->topics[topicIndx] = NULL;
-    }
-    else
+    if (!S__topicRemove(mqttCtrl, &mqttCtrl->topicRoot, topicCtrl->topicName, topicCtrl))
     {
-        return resultCode__preConditionFailed;
+        return resultCode__preConditionFailed;                                                  // not subscribed
     }
 
     if (mqttCtrl->state == mqttState_connected)
     {
-        S__notifyServerTopicChange(mqttCtrl, topicIndx, false);
+        return S__notifyServerTopicChange(mqttCtrl, topicCtrl, false);
     }
-    return resultCode__conflict;
+    return resultCode__success;
 }
 
 
@@ -378,25 +421,244 @@ resultCode_t mqtt_publish(mqttCtrl_t *mqttCtrl, const char *topic, mqttQos_t qos
     ASSERT(messageSz <= 4096);                                                                                  // max msg length PUB=4096 (PUBEX=560)
     
     resultCode_t rslt = resultCode__conflict;                                                                   // assume lock not obtainable, conflict
-    uint32_t timeoutMS = (timeoutSec == 0) ? mqtt__publishTimeout : PERIOD_FROM_SECONDS(timeoutSec * 1000);
+    uint32_t timeoutMS = (timeoutSec == 0) ? mqtt__publishTimeout : PERIOD_FROM_SECONDS(timeoutSec);
+    uint32_t publishStart = pMillis();
 
-        mqttCtrl->sentMsgId++;                                                                                  // keep sequence going regardless of MQTT QOS
-        uint16_t msgId = ((uint8_t)qos == 0) ? 0 : mqttCtrl->sentMsgId;                                         // msgId not sent with QOS == 0, otherwise sent
-        // AT+QMTPUB=<tcpconnectID>,<msgID>,<qos>,<retain>,"<topic>"
+    mqttCtrl->sentMsgId++;                                                                                      // keep sequence going regardless of MQTT QOS
+    uint16_t msgId = ((uint8_t)qos == 0) ? 0 : mqttCtrl->sentMsgId;                                             // msgId not sent with QOS == 0, otherwise sent
 
+    if (S__mqttPublishInlineEligible(topic, message, messageSz))
+    {
+        // AT+QMTPUBEX=<tcpconnectID>,<msgID>,<qos>,<retain>,"<topic>","<msg>"   message in command, no "> " prompt turnaround
+        if (atcmd_tryInvoke("AT+QMTPUBEX=%d,%d,%d,0,\"%s\",\"%.*s\"", mqttCtrl->dataCntxt, msgId, qos, topic, messageSz, message))
+        {
+            rslt = atcmd_awaitResultWithOptions(timeoutMS, S__mqttPublishExCompleteParser);
+            mqttCtrl->statsPublishInline++;
+        }
+    }
+    else
+    {
+        // AT+QMTPUB=<tcpconnectID>,<msgID>,<qos>,<retain>,"<topic>",<length>
         atcmd_configDataMode(mqttCtrl->dataCntxt, "> ", atcmd_stdTxDataHndlr, message, messageSz, NULL, false); // send message with dataMode
-
         if (atcmd_tryInvoke("AT+QMTPUB=%d,%d,%d,0,\"%s\",%d", mqttCtrl->dataCntxt, msgId, qos, topic, messageSz))
         {
             rslt = atcmd_awaitResultWithOptions(timeoutMS, S__mqttPublishCompleteParser);
-            if (rslt == resultCode__success)                                        
+        }
+    }
+
+    if (rslt == resultCode__success && atcmd_getValue() == mqttResult_failed)                                  // server result: 0=sent/acknowledged, 2=failed
+        rslt = resultCode__gtwyTimeout;
+    mqttCtrl->statsPublishSyncMs = pMillis() - publishStart;
+    PRINTF(dbgColor__dYellow, "MQTT-PUB rslt=%d sz=%d duration=%d\r", rslt, messageSz, mqttCtrl->statsPublishSyncMs);
+    return rslt;
+}
+
+
+/** 
+ *  @brief Publish a message produced in chunks by an application callback.
+*/
+resultCode_t mqtt_publishFromProducer(mqttCtrl_t *mqttCtrl, const char *topic, mqttQos_t qos, uint16_t messageSz, mqttPublishProducer_func producer, char *workBffr, uint16_t workBffrSz, mqttPublishResult_t *publishResult)
+{
+    ASSERT(producer != NULL && workBffr != NULL && workBffrSz >= 2);
+    ASSERT(messageSz > 0 && messageSz <= mqtt__publishMaxSz);
+
+    resultCode_t rslt = resultCode__conflict;
+    uint32_t startTime = pMillis();
+
+    mqttCtrl->sentMsgId++;
+    uint16_t msgId = ((uint8_t)qos == 0) ? 0 : mqttCtrl->sentMsgId;
+    mqttCtrl->txProducer = producer;
+    mqttCtrl->txRemaining = messageSz;
+    mqttCtrl->txChunks = 0;
+
+    // AT+QMTPUB=<tcpconnectID>,<msgID>,<qos>,<retain>,"<topic>",<length>   data handler streams producer chunks
+    atcmd_configDataMode(mqttCtrl->dataCntxt, "> ", S__mqttProducerTxDataHndlr, workBffr, workBffrSz, NULL, false);
+    if (atcmd_tryInvoke("AT+QMTPUB=%d,%d,%d,0,\"%s\",%d", mqttCtrl->dataCntxt, msgId, qos, topic, messageSz))
+    {
+        rslt = atcmd_awaitResultWithOptions(mqtt__publishTimeout, S__mqttPublishCompleteParser);
+        if (rslt == resultCode__success && atcmd_getValue() == mqttResult_failed)
+            rslt = resultCode__gtwyTimeout;
+    }
+    mqttCtrl->txProducer = NULL;
+
+    if (publishResult != NULL)
+    {
+        publishResult->bytesSent = messageSz - mqttCtrl->txRemaining;
+        publishResult->chunks = mqttCtrl->txChunks;
+        publishResult->durationMs = pMillis() - startTime;
+        publishResult->throughputBps = (publishResult->durationMs > 0) ? (publishResult->bytesSent * 1000) / publishResult->durationMs : publishResult->bytesSent;
+        PRINTF(dbgColor__dYellow, "MQTT-PUB producer rslt=%d bytes=%lu chunks=%d %lums %luB/s\r", rslt, publishResult->bytesSent, publishResult->chunks, publishResult->durationMs, publishResult->throughputBps);
+    }
+    return rslt;
+}
+
+
+/**
+ *  @brief Set BGx message receive mode, applied at open.
+*/
+void mqtt_setRecvBuffered(mqttCtrl_t *mqttCtrl, bool buffered)
+{
+    ASSERT(mqttCtrl->state == mqttState_closed);                // BGx receive mode is configured prior to open
+    mqttCtrl->recvBuffered = buffered;
+}
+
+
+/**
+ *  @brief Get the number of messages held at the BGx (buffered receive mode), as signaled by URC.
+*/
+uint8_t mqtt_getRecvPendingCnt(mqttCtrl_t *mqttCtrl)
+{
+    return S__bitCount(mqttCtrl->recvPending);
+}
+
+
+/**
+ *  @brief Query the BGx for buffer occupancy (buffered receive mode), refreshes the pending count.
+*/
+uint8_t mqtt_fetchRecvStatus(mqttCtrl_t *mqttCtrl)
+{
+    // AT+QMTRECV?  +QMTRECV: <client_idx>,<status_0>,<status_1>,<status_2>,<status_3>,<status_4>  (line per client)
+    if (atcmd_tryInvoke("AT+QMTRECV?") && atcmd_awaitResult() == resultCode__success)
+    {
+        char clientPrefix[16];
+        snprintf(clientPrefix, sizeof(clientPrefix), "+QMTRECV: %d,", mqttCtrl->dataCntxt);
+        char *workPtr = strstr(g_lqLTEM.atcmd->rawResponse, clientPrefix);
+        if (workPtr != NULL)
+        {
+            workPtr += strlen(clientPrefix);
+            mqttCtrl->recvPending = 0;
+            for (uint8_t slot = 0; slot < mqtt__recvBufferSlots; slot++)
             {
-                atcmd_close();
-                PRINTF(dbgColor__dYellow, "MQTT-PUB Success: rslt=%d\r", rslt);
-                return rslt;
+                if (strtol(workPtr, &workPtr, 10) == 1)
+                    mqttCtrl->recvPending |= (1 << slot);
+                workPtr++;                                                  // skip delimiter
             }
         }
-        return resultCode__conflict;
+    }
+    return S__bitCount(mqttCtrl->recvPending);
+}
+
+
+/**
+ *  @brief Read one message held at the BGx (buffered receive mode).
+*/
+resultCode_t mqtt_fetchRecv(mqttCtrl_t *mqttCtrl)
+{
+    ASSERT(mqttCtrl->recvBuffered);
+
+    for (uint8_t slot = 0; slot < mqtt__recvBufferSlots; slot++)
+    {
+        if (mqttCtrl->recvPending & (1 << slot))
+        {
+            resultCode_t rslt = resultCode__conflict;
+            atcmd_configDataMode(mqttCtrl->dataCntxt, "+QMTRECV: ", S__mqttRecvDataHndlr, NULL, 0, NULL, false);
+            if (atcmd_tryInvoke("AT+QMTRECV=%d,%d", mqttCtrl->dataCntxt, slot))
+            {
+                rslt = atcmd_awaitResult();
+            }
+            if (rslt == resultCode__success)
+            {
+                mqttCtrl->recvPending &= ~(1 << slot);                      // BGx releases slot on read
+            }
+            return rslt;
+        }
+    }
+    return resultCode__notFound;
+}
+
+
+/**
+ *  @brief Set the number of async publishes that can be outstanding (awaiting server acknowledgement) at once.
+*/
+void mqtt_setPublishWindow(mqttCtrl_t *mqttCtrl, uint8_t windowSz)
+{
+    ASSERT(windowSz > 0 && windowSz <= mqtt__inflightCnt);
+    mqttCtrl->inflightWindow = windowSz;
+}
+
+
+/** 
+ *  @brief Publish a QOS1/QOS2 message without waiting for the server acknowledgement.
+*/
+resultCode_t mqtt_publishAsync(mqttCtrl_t *mqttCtrl, const char *topic, mqttQos_t qos, const char *message, uint16_t messageSz, mqttPublishDone_func doneCB)
+{
+    ASSERT(messageSz <= 4096);                                                                                  // max msg length PUB=4096 (PUBEX=560)
+    ASSERT(qos != mqttQos_0);                                                                                   // no QOS0 acknowledgement to track
+
+    uint32_t waitStart = pMillis();
+    while (mqttCtrl->inflightCnt >= mqttCtrl->inflightWindow)                                                  // window full, service URCs until a publish completes
+    {
+        S__mqttExpireInflight(mqttCtrl);
+        if (pElapsed(waitStart, mqtt__publishTimeout))
+            return resultCode__timeout;
+        ltem_eventMgr();
+        pYield();
+    }
+
+    mqttInflight_t *inflight = NULL;
+    for (size_t i = 0; i < mqtt__inflightCnt; i++)
+    {
+        if (mqttCtrl->inflight[i].msgId == 0)
+        {
+            inflight = &mqttCtrl->inflight[i];
+            break;
+        }
+    }
+    ASSERT(inflight != NULL);
+
+    if (++mqttCtrl->sentMsgId == 0)                                                                             // QOS1/QOS2 msgId range is 1-65535
+        mqttCtrl->sentMsgId = 1;
+    inflight->msgId = mqttCtrl->sentMsgId;
+    inflight->retransmits = 0;
+    inflight->doneCB = doneCB;
+    inflight->sentAt = pMillis();
+    mqttCtrl->inflightCnt++;                                                                                    // in table before result URC can arrive
+
+    resultCode_t rslt = resultCode__conflict;
+    if (S__mqttPublishInlineEligible(topic, message, messageSz))
+    {
+        if (atcmd_tryInvoke("AT+QMTPUBEX=%d,%d,%d,0,\"%s\",\"%.*s\"", mqttCtrl->dataCntxt, inflight->msgId, qos, topic, messageSz, message))
+        {
+            rslt = atcmd_awaitResult();                                                                         // OK = accepted by BGx, +QMTPUBEX URC follows
+            mqttCtrl->statsPublishInline++;
+
+            char *ackPtr = strstr(atcmd_getRawResponse(), "+QMTPUBEX: ");                                    // result received with OK, popped into response
+            if (rslt == resultCode__success && ackPtr != NULL && strstr(ackPtr, "\r\n") != NULL)
+                S__mqttPublishAck(ackPtr);
+        }
+    }
+    else
+    {
+        atcmd_configDataMode(mqttCtrl->dataCntxt, "> ", atcmd_stdTxDataHndlr, message, messageSz, NULL, true);     // data handler consumes OK, +QMTPUB URC left in rxBffr
+        if (atcmd_tryInvoke("AT+QMTPUB=%d,%d,%d,0,\"%s\",%d", mqttCtrl->dataCntxt, inflight->msgId, qos, topic, messageSz))
+        {
+            rslt = atcmd_awaitResult();                                                                         // OK = accepted by BGx, +QMTPUB URC follows
+        }
+    }
+    if (rslt != resultCode__success)
+    {
+        inflight->msgId = 0;
+        mqttCtrl->inflightCnt--;
+    }
+    return rslt;
+}
+
+
+/** 
+ *  @brief Wait for all outstanding async publishes to complete.
+*/
+resultCode_t mqtt_awaitPublishes(mqttCtrl_t *mqttCtrl, uint32_t timeoutMS)
+{
+    uint32_t waitStart = pMillis();
+    while (mqttCtrl->inflightCnt > 0)
+    {
+        S__mqttExpireInflight(mqttCtrl);
+        if (pElapsed(waitStart, timeoutMS))
+            return resultCode__timeout;
+        ltem_eventMgr();
+        pYield();
+    }
+    return resultCode__success;
 }
 
 
@@ -412,8 +674,7 @@ void mqtt_close(mqttCtrl_t *mqttCtrl)
         if (atcmd_tryInvoke("AT+QMTCLOSE=%d", mqttCtrl->dataCntxt))
             atcmd_awaitResultWithOptions(5000, NULL);
     }
-    mqttCtrl->state == mqttState_closed;
-    return resultCode__success;
+    mqttCtrl->state = mqttState_closed;
 }
 
 
@@ -431,7 +692,21 @@ resultCode_t mqtt_reset(mqttCtrl_t *mqttCtrl, bool resetModem)
     {
         ltem_start(resetAction_swReset);
     }
-    mqtt_start(mqttCtrl, true);
+    return mqtt_start(mqttCtrl, true);
+}
+
+
+/**
+ *  @brief Enable background recovery of a lost server connection.
+*/
+void mqtt_setAutoReconnect(mqttCtrl_t *mqttCtrl, bool enable)
+{
+    mqttCtrl->autoReconnect = enable;
+    mqttCtrl->recoverStage = mqttRecover_idle;
+    if (enable)
+    {
+        LTEM_registerDoWorker(S__mqttDoWork);                                   // connection recovery is performed in background
+    }
 }
 
 
@@ -491,7 +766,7 @@ mqttState_t mqtt_fetchStatus(mqttCtrl_t *mqttCtrl)
 */
 uint16_t mqtt_getSentMsgId(mqttCtrl_t *mqttCtrl)
 {
-    mqttCtrl->sentMsgId;
+    return mqttCtrl->sentMsgId;
 }
 
 
@@ -500,7 +775,7 @@ uint16_t mqtt_getSentMsgId(mqttCtrl_t *mqttCtrl)
 */
 uint16_t mqtt_getRecvMsgId(mqttCtrl_t *mqttCtrl)
 {
-    mqttCtrl->recvMsgId;
+    return mqttCtrl->recvMsgId;
 }
 
 
@@ -509,7 +784,7 @@ uint16_t mqtt_getRecvMsgId(mqttCtrl_t *mqttCtrl)
 */
 uint16_t mqtt_getErrCode(mqttCtrl_t *mqttCtrl)
 {
-    mqttCtrl->errCode;
+    return mqttCtrl->errCode;
 }
 
 
@@ -520,36 +795,180 @@ uint16_t mqtt_getErrCode(mqttCtrl_t *mqttCtrl)
 #pragma region private functions
 
 
-static uint8_t S__findtopicIndx(mqttCtrl_t* mqttCntl, mqttTopicCtrl_t* topicCtrl)
+/**
+ *  @brief Add subscription to topic trie, one node per filter level.
+ *  @return False if topic node pool exhausted
+ */
+static bool S__topicInsert(mqttCtrl_t *mqttCtrl, mqttTopicCtrl_t *topicCtrl)
+{
+    mqttTopicNode_t **nodeLink = &mqttCtrl->topicRoot;
+    const char *level = topicCtrl->topicName;
+    mqttTopicNode_t *node = NULL;
+
+    while (true)
+    {
+        const char *levelEnd = strchr(level, '/');
+        uint16_t levelLen = (levelEnd != NULL) ? levelEnd - level : strlen(level);
+        ASSERT(levelLen < mqtt__topicLevelSz);
+
+        for (node = *nodeLink; node != NULL; node = node->sibling)                              // existing level node
+        {
+            if (strlen(node->level) == levelLen && memcmp(node->level, level, levelLen) == 0)
+                break;
+        }
+        if (node == NULL)                                                                       // new level node from pool
+        {
+            if (mqttCtrl->topicFree == NULL)
+                return false;
+            node = mqttCtrl->topicFree;
+            mqttCtrl->topicFree = node->sibling;
+            memset(node, 0, sizeof(mqttTopicNode_t));
+            memcpy(node->level, level, levelLen);
+            node->sibling = *nodeLink;
+            *nodeLink = node;
+        }
+
+        if (levelEnd == NULL)
+            break;
+        nodeLink = &node->child;
+        level = levelEnd + 1;
+    }
+    node->topicCtrl = topicCtrl;                                                                // same filter resubscribed: replaces control
+    return true;
+}
+
+
+/**
+ *  @brief Remove subscription from topic trie, returning nodes no longer used to the pool.
+ *  @return True if subscription was found
+ */
+static bool S__topicRemove(mqttCtrl_t *mqttCtrl, mqttTopicNode_t **nodeLink, const char *filter, mqttTopicCtrl_t *topicCtrl)
 {
-    uint8_t emptySlot = UINT8_MAX;
+    const char *levelEnd = strchr(filter, '/');
+    uint16_t levelLen = (levelEnd != NULL) ? levelEnd - filter : strlen(filter);
 
-    for (size_t i = 0; i < mqtt__topicsCnt; i++)
+    for (; *nodeLink != NULL; nodeLink = &(*nodeLink)->sibling)
     {
-        if (mqttCntl->topics[i] == NULL)
+        mqttTopicNode_t *node = *nodeLink;
+        if (strlen(node->level) != levelLen || memcmp(node->level, filter, levelLen) != 0)
+            continue;
+
+        bool found = false;
+        if (levelEnd == NULL)
         {
-            emptySlot = MIN(i, emptySlot);
+            found = node->topicCtrl == topicCtrl;
+            if (found)
+                node->topicCtrl = NULL;
         }
         else
         {
-            if (memcmp(mqttCntl->topics[i]->topicName, topicCtrl->topicName, mqtt__topic_nameSz) == 0)
+            found = S__topicRemove(mqttCtrl, &node->child, levelEnd + 1, topicCtrl);
+        }
+
+        if (node->topicCtrl == NULL && node->child == NULL)                                     // prune unused node
+        {
+            *nodeLink = node->sibling;
+            node->sibling = mqttCtrl->topicFree;
+            mqttCtrl->topicFree = node;
+        }
+        return found;
+    }
+    return false;
+}
+
+
+/**
+ *  @brief Find subscription matching a received topic, descending one trie level per topic level.
+ *  @details Topic is matched in place in rxBffr (not copied), levels are compared with cbffr_find() which handles buffer wrap.
+ *  @param rxBffr [in] Receive buffer, tail at start of received topic.
+ *  @param node [in] First node of trie level to match.
+ *  @param topicLen [in] Length of received topic.
+ *  @param levelStart [in] Offset in topic of level to match.
+ *  @param prefixLen [out] Length of topic matched by filter levels preceding a '#', topic length if no '#'.
+ *  @return Matching subscription, NULL if none.
+ */
+static mqttTopicCtrl_t* S__topicMatch(cBuffer_t *rxBffr, mqttTopicNode_t *node, uint16_t topicLen, uint16_t levelStart, uint16_t *prefixLen)
+{
+    int16_t levelEnd = (topicLen > levelStart) ? cbffr_find(rxBffr, "/", levelStart, topicLen - levelStart, false) : -1;
+    bool lastLevel = CBFFR_NOTFOUND(levelEnd) || levelEnd >= topicLen;
+    uint16_t levelLen = lastLevel ? topicLen - levelStart : levelEnd - levelStart;
+    bool wildcardAllowed = levelStart > 0 || cbffr_find(rxBffr, "$", 0, 1, false) != 0;        // MQTT: wildcard first level does not match $topics
+    mqttTopicNode_t *multiLevel = NULL;
+
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->level[0] == '#')
+        {
+            multiLevel = wildcardAllowed ? node : NULL;
+            continue;
+        }
+        bool isMatch;
+        if (node->level[0] == '+' && node->level[1] == '\0')
+            isMatch = wildcardAllowed;
+        else if (levelLen == 0)
+            isMatch = node->level[0] == '\0';
+        else                                                                                    // compare in place, rxBffr wrap safe
+            isMatch = strlen(node->level) == levelLen && cbffr_find(rxBffr, node->level, levelStart, levelLen, false) == levelStart;
+        if (!isMatch)
+            continue;
+
+        if (lastLevel)
+        {
+            if (node->topicCtrl != NULL)
             {
-                return i;
+                *prefixLen = topicLen;
+                return node->topicCtrl;
             }
+            for (mqttTopicNode_t *child = node->child; child != NULL; child = child->sibling)  // "a/#" also matches "a"
+            {
+                if (child->level[0] == '#' && child->topicCtrl != NULL)
+                {
+                    *prefixLen = topicLen;
+                    return child->topicCtrl;
+                }
+            }
+        }
+        else
+        {
+            mqttTopicCtrl_t *topicCtrl = S__topicMatch(rxBffr, node->child, topicLen, levelStart + levelLen + 1, prefixLen);
+            if (topicCtrl != NULL)
+                return topicCtrl;
         }
     }
-    return emptySlot;
+
+    if (multiLevel != NULL && multiLevel->topicCtrl != NULL)
+    {
+        *prefixLen = (levelStart > 0) ? levelStart - 1 : 0;                                     // exclude level separator
+        return multiLevel->topicCtrl;
+    }
+    return NULL;
 }
 
 
-static resultCode_t S__notifyServerTopicChange(mqttCtrl_t* mqttCtrl, mqttTopicCtrl_t* topicCtrl, bool subscribe)
+/**
+ *  @brief Subscribe all topics in trie with server (connect/reconnect).
+ */
+static resultCode_t S__topicResubscribe(mqttCtrl_t *mqttCtrl, mqttTopicNode_t *node)
 {
-    char topicName[mqtt__topic_nameSz + 1];
-    strcpy(topicName, topicCtrl->topicName);
-    if (topicCtrl->wildcard)
+    for (; node != NULL; node = node->sibling)
     {
-        strcat(topicName, "/#");
+        if (node->topicCtrl != NULL)
+        {
+            resultCode_t rslt = S__notifyServerTopicChange(mqttCtrl, node->topicCtrl, true);
+            if (rslt != resultCode__success)
+                return rslt;
+        }
+        resultCode_t rslt = S__topicResubscribe(mqttCtrl, node->child);
+        if (rslt != resultCode__success)
+            return rslt;
     }
+    return resultCode__success;
+}
+
+
+static resultCode_t S__notifyServerTopicChange(mqttCtrl_t* mqttCtrl, mqttTopicCtrl_t* topicCtrl, bool subscribe)
+{
+    const char *topicName = topicCtrl->topicName;
 
     if (subscribe)
     {
@@ -565,126 +984,562 @@ static resultCode_t S__notifyServerTopicChange(mqttCtrl_t* mqttCtrl, mqttTopicCt
             return atcmd_awaitResult();
         }
     }
+    return resultCode__conflict;
 }
 
 
-static void S__mqttUrcHandler()
+/**
+ *  @brief MQTT URC handler: async publish results, received messages and connection status changes.
+ */
+static resultCode_t S__mqttUrcHandler()
 {
     cBuffer_t* rxBffr = g_lqLTEM.iop->rxBffr;                                               // for convenience
 
     /*
-    +QMTRECV: <tcpconnectID>,<msgID>,"<topic>","<payload>"
-    +QMTRECV: 5,65535,"<topic>","<payload>"
+    +QMTPUB: <tcpconnectID>,<msgID>,<result>[,<value>]
+    +QMTRECV: <tcpconnectID>,<msgID>,"<topic>",<payload_len>,"<payload>"
+    +QMTRECV: 5,65535,"<topic>",<payload_len>,"<payload>"
     +QMTSTAT: <tcpconnectID>,<err_code>
     */
 
-    if (CBFFR_NOTFOUND(cbffr_find(rxBffr, "+QMT", 0, 0, false)) ||                          // not a MQTT URC
-        cbffr_getOccupied(rxBffr) < 20)                                                     // -or- not sufficient chars to parse URC header
+    if (CBFFR_NOTFOUND(cbffr_find(rxBffr, "+QMT", 0, 0, false)))                            // not a MQTT URC
     {
-        return;                                                     
+        return resultCode__cancelled;                                                     
     }
 
-    char workBffr[512] = {0};
-    char* workPtr = workBffr;
-    uint8_t dataCntxt;
+    if (S__mqttPublishUrc(rxBffr))                                                          // async publish result (any MQTT connection)
+    {
+        return resultCode__success;
+    }
 
     /* MQTT Receive Message
      * -------------------------------------------------------------------------------------
      */
-    if (CBFFR_FOUND(cbffr_find(rxBffr, "+QMTRECV:", 0, 0, true)))                           // if recv, move tail to start of header
+    for (size_t i = 0; i < ltem__streamCnt; i++)
     {
-        // separator: "topic","message"           ,"            search offset from URC prefix
-        uint16_t findIndx = cbffr_find(rxBffr, "\",\"", sizeof("+QMTRECV: "), 2, false);        
-        if (CBFFR_NOTFOUND(findIndx))
+        streamCtrl_t *streamCtrl = g_lqLTEM.streams[i];
+        if (streamCtrl == NULL || streamCtrl->streamType != streamType_MQTT)
+            continue;
+
+        mqttCtrl_t *mqttCtrl = (mqttCtrl_t*)streamCtrl;
+        if (mqttCtrl->recvBuffered)                                                         // BGx buffered, URC signals slot (read response is data mode)
         {
-            return;
+            if (S__mqttRecvSignalUrc(mqttCtrl, rxBffr))
+                return resultCode__success;
+            continue;
         }
-        ASSERT(findIndx < sizeof(workBffr));
-        cbffr_pop(rxBffr, workBffr, findIndx + 3);                                          // rxBffr->tail now points to message, operate on header in workBffr
 
-        workPtr += sizeof("+QMTRECV: ") - 1;
-        dataCntxt = strtol(workPtr, &workPtr, 10);
-        workPtr++;
-        uint16_t msgId = strtol(workPtr, &workPtr, 10);
+        char urcPrefix[16];
+        snprintf(urcPrefix, sizeof(urcPrefix), "+QMTRECV: %d,", mqttCtrl->dataCntxt);
+        int16_t urcIndx = cbffr_find(rxBffr, urcPrefix, 0, 0, false);
+        if (CBFFR_FOUND(urcIndx))
+        {
+            if (ATCMD_isLockActive() && urcIndx > 2)                                        // command response precedes (2 = leading line-end)
+                continue;
+            cbffr_skipTail(rxBffr, urcIndx);                                                // move tail to start of header
+            S__mqttStreamMessage(rxBffr);                                                   // header incomplete: come back later
+            return resultCode__success;
+        }
+    }
 
-        // find topic in ctrl, to get callback func
-        streamType_t* ctrlPtr = ltem_getStreamFromCntxt(dataCntxt, streamType_MQTT);
-        ASSERT(ctrlPtr != NULL);
-        mqttCtrl_t* mqttCtrl = (mqttCtrl_t*)ctrlPtr;
+    char workBffr[80] = {0};
+    char* workPtr = workBffr;
 
-        mqttTopicCtrl_t* topicCtrl;
-        uint16_t topicLen;
-        workPtr += 2;
-        bool topicFound = false;
-        for (size_t i = 0; i < mqtt__topicsCnt; i++)
+    /* MQTT Status Change
+     * ------------------------------------------------------------------------------------- */
+    int16_t urcIndx = cbffr_find(rxBffr, "+QMTSTAT", 0, 0, false);
+    if (CBFFR_FOUND(urcIndx) && (!ATCMD_isLockActive() || urcIndx <= 2))                   // MQTT connection closed
+    {
+        int16_t eopUrl = cbffr_find(rxBffr, "\r\n", urcIndx, sizeof(workBffr) - 1, false);
+        if (CBFFR_FOUND(eopUrl))
         {
-            if (mqttCtrl->topics[i]->wildcard)                                              // wildcard: compare length of registered topic name (suffix prev removed)
-            {
-                topicLen = strlen(mqttCtrl->topics[i]->topicName);
-            }
-            else                                                                            // no wildcard: compare length of received topic name (full name)
-            {
-                uint16_t bffrLen = workBffr + sizeof(workBffr) - workPtr;
-                topicLen = memchr(workPtr, '\"', bffrLen) - (void*)workPtr;
-            }
-            if (memcmp(mqttCtrl->topics[i]->topicName, workPtr, topicLen) == 0)             // found topic control
+            cbffr_skipTail(rxBffr, urcIndx);
+            cbffr_pop(rxBffr, workBffr, eopUrl - urcIndx + 2);
+            workPtr = workBffr + sizeof("+QMTSTAT: ") - 1;
+
+            uint8_t cntxt = strtol(workPtr, &workPtr, 10);
+            workPtr++;
+
+            streamCtrl_t* streamCtrl = ltem_getStreamFromCntxt(cntxt, streamType_MQTT);
+            ASSERT(streamCtrl != NULL);
+            ((mqttCtrl_t*)streamCtrl)->errCode = strtol(workPtr, NULL, 10);
+            ((mqttCtrl_t*)streamCtrl)->state = mqttState_closed;
+        }
+        return resultCode__success;
+    }
+    return resultCode__cancelled;
+}
+
+
+/**
+ *  @brief Service buffered receive signal URC: +QMTRECV: <client_idx>,<recv_id>
+ *  @details The AT+QMTRECV read response shares the prefix, it is distinguished by the quoted topic following the msgID.
+ *  @return True if URC was a receive signal for this client (serviced, or incomplete and will be on next pass)
+ */
+static bool S__mqttRecvSignalUrc(mqttCtrl_t *mqttCtrl, cBuffer_t *rxBffr)
+{
+    char urcPrefix[16];
+    snprintf(urcPrefix, sizeof(urcPrefix), "+QMTRECV: %d,", mqttCtrl->dataCntxt);
+    int16_t urcIndx = cbffr_find(rxBffr, urcPrefix, 0, 0, false);
+    if (CBFFR_NOTFOUND(urcIndx))
+        return false;
+    if (ATCMD_isLockActive() && urcIndx > 2)                                                // command response precedes (2 = leading line-end)
+        return false;
+
+    uint8_t searchSz = strlen(urcPrefix) + 8;                                               // covers read response: prefix + msgID(5) + ,"
+    int16_t eolIndx = cbffr_find(rxBffr, "\r\n", urcIndx, searchSz, false);
+    int16_t quoteIndx = cbffr_find(rxBffr, "\"", urcIndx, searchSz, false);
+    if (CBFFR_FOUND(quoteIndx) && (CBFFR_NOTFOUND(eolIndx) || quoteIndx < eolIndx))       // read response (data mode), not a signal
+        return false;
+    if (CBFFR_NOTFOUND(eolIndx))
+        return true;                                                                        // don't have full URC line yet, come back later
+
+    char workBffr[24] = {0};
+    cbffr_skipTail(rxBffr, urcIndx);
+    cbffr_pop(rxBffr, workBffr, eolIndx - urcIndx + 2);
+    uint8_t slot = strtol(workBffr + strlen(urcPrefix), NULL, 10);
+    if (slot < mqtt__recvBufferSlots)
+    {
+        mqttCtrl->recvPending |= (1 << slot);
+        mqttCtrl->statsRecvBufferedPeak = MAX(mqttCtrl->statsRecvBufferedPeak, S__bitCount(mqttCtrl->recvPending));
+    }
+    PRINTF(dbgColor__dCyan, "mqttRecvSignal() cntxt=%d slot=%d pending=%02X\r", mqttCtrl->dataCntxt, slot, mqttCtrl->recvPending);
+    return true;
+}
+
+
+/**
+ *  @brief Data mode handler for buffered receive read (AT+QMTRECV=<client_idx>,<recv_id>), response is message in URC form.
+ */
+static resultCode_t S__mqttRecvDataHndlr()
+{
+    cBuffer_t *rxBffr = g_lqLTEM.iop->rxBffr;
+    uint32_t readStart = pMillis();
+
+    cbffr_find(rxBffr, "+QMTRECV: ", 0, 0, true);                                           // move tail to start of header
+    while (!S__mqttStreamMessage(rxBffr))                                                   // wait for complete header
+    {
+        if (pElapsed(readStart, mqtt__recvReadTimeoutMs))
+            return resultCode__timeout;
+        pYield();
+    }
+    return resultCode__success;
+}
+
+
+/**
+ *  @brief Stream a received message to the application topic callback, rxBffr tail is at +QMTRECV header.
+ *  @details +QMTRECV: <client_idx>,<msgID>,"<topic>",<payload_len>,"<payload>"
+ *           Header fields are located in place with cbffr_find(); only the numeric fields are copied (small stack buffer). The
+ *           topic is matched in rxBffr and delivered zero-copy, a topic wrapping the end of rxBffr is delivered in 2 segments.
+ *           Payload is framed by length (binary safe), exactly payload_len bytes are streamed without scanning content.
+ *  @return False if message header is not complete, nothing consumed from rxBffr.
+ */
+static bool S__mqttStreamMessage(cBuffer_t *rxBffr)
+{
+    int16_t topicOpen = cbffr_find(rxBffr, "\"", 0, mqtt__recvHeaderPrefixSz, false);
+    if (CBFFR_NOTFOUND(topicOpen))
+        return false;
+    int16_t topicClose = cbffr_find(rxBffr, "\",", topicOpen + 1, mqtt__topicSz, false);
+    if (CBFFR_NOTFOUND(topicClose))
+        return false;
+    int16_t payloadOpen = cbffr_find(rxBffr, ",\"", topicClose + 2, 8, false);                 // payload_len is 1-5 digits
+    if (CBFFR_NOTFOUND(payloadOpen))
+        return false;
+
+    uint16_t fullTopicLen = topicClose - topicOpen - 1;
+    uint8_t lenFieldSz = payloadOpen + 2 - topicClose;                                      // ",<payload_len>,"
+    char numBffr[mqtt__recvHeaderPrefixSz + 1];
+
+    cbffr_pop(rxBffr, numBffr, topicOpen + 1);                                              // +QMTRECV: <client_idx>,<msgID>,"
+    numBffr[topicOpen + 1] = '\0';
+    char *workPtr = numBffr + sizeof("+QMTRECV: ") - 1;
+    uint8_t dataCntxt = strtol(workPtr, &workPtr, 10);
+    uint16_t msgId = strtol(workPtr + 1, NULL, 10);
+
+    // find topic in ctrl, to get callback func
+    mqttCtrl_t* mqttCtrl = (mqttCtrl_t*)ltem_getStreamFromCntxt(dataCntxt, streamType_MQTT);
+    ASSERT(mqttCtrl != NULL);
+    uint16_t topicLen;
+    mqttTopicCtrl_t* topicCtrl = S__topicMatch(rxBffr, mqttCtrl->topicRoot, fullTopicLen, 0, &topicLen);
+
+    if (topicCtrl == NULL)                                                                  // no subscription (persisted session, topic cancelled offline)
+    {
+        PRINTF(dbgColor__warn, "mqttUrcHndlr() no subscription for topic, msgId=%d discarded\r", msgId);
+        mqttCtrl->statsRecvUnmatched++;
+        cbffr_skipTail(rxBffr, fullTopicLen);                                               // message is streamed below without delivery
+    }
+    else                                                                                    // forward topic, then topic extension (levels matched by '#' wildcard)
+    {
+        S__mqttDeliverSegment(rxBffr, topicCtrl, dataCntxt, msgId, mqttMsgSegment_topic, topicLen);
+        if (topicLen < fullTopicLen)
+        {
+            if (topicLen > 0)
+                cbffr_skipTail(rxBffr, 1);                                                  // skip level separator
+            S__mqttDeliverSegment(rxBffr, topicCtrl, dataCntxt, msgId, mqttMsgSegment_topicExt, fullTopicLen - ((topicLen > 0) ? topicLen + 1 : 0));
+        }
+    }
+
+    cbffr_pop(rxBffr, numBffr, lenFieldSz);
+    numBffr[lenFieldSz] = '\0';
+    uint16_t payloadLen = strtol(numBffr + 2, NULL, 10);                                    // skip ",
+
+    // stream payload_len bytes, message content is not examined
+    char* streamPtr;
+    uint16_t reqstBlockSz = cbffr_getCapacity(rxBffr) / 4;
+    uint16_t remaining = payloadLen;
+    uint32_t lastRecvAt = pMillis();
+    if (payloadLen == 0 && topicCtrl != NULL)
+    {
+        ((mqttAppRecv_func)topicCtrl->appRecvDataCB)(dataCntxt, msgId, mqttMsgSegment_msgBody, NULL, 0, true);
+    }
+    while (remaining > 0)
+    {
+        uint16_t blockSz = cbffr_popBlock(rxBffr, &streamPtr, MIN(remaining, reqstBlockSz));
+        if (blockSz == 0)
+        {
+            if (pElapsed(lastRecvAt, mqtt__recvReadTimeoutMs))                          // message truncated, close out with app
             {
-                topicFound = true;
-                topicCtrl = mqttCtrl->topics[i];
-                break;
+                PRINTF(dbgColor__warn, "mqttUrcHndlr() msgBody timeout, remaining=%d\r", remaining);
+                if (topicCtrl != NULL)
+                    ((mqttAppRecv_func)topicCtrl->appRecvDataCB)(dataCntxt, msgId, mqttMsgSegment_msgBody, NULL, 0, true);
+                return true;
             }
+            pYield();
+            continue;
         }
-        ASSERT(topicFound);                                                                 // assert that we can find topic that we told server to send us
+        remaining -= blockSz;
+        lastRecvAt = pMillis();
+
+        PRINTF(dbgColor__dCyan, "mqttUrcHndlr() msgBody ptr=%p blkSz=%d isFinal=%d\r", streamPtr, blockSz, remaining == 0);
+
+        // signal new receive data available to host application
+        if (topicCtrl != NULL)
+            ((mqttAppRecv_func)topicCtrl->appRecvDataCB)(dataCntxt, msgId, mqttMsgSegment_msgBody, streamPtr, blockSz, remaining == 0);
+
+        cbffr_popBlockFinalize(rxBffr, true);                                           // commit POP
+    }
+
+    // discard payload close: "\r\n
+    while (cbffr_getOccupied(rxBffr) < 3 && !pElapsed(lastRecvAt, mqtt__recvReadTimeoutMs))
+    {
+        pYield();
+    }
+    cbffr_skipTail(rxBffr, MIN(cbffr_getOccupied(rxBffr), 3));
+    return true;
+}
 
-        // forward topic
-        PRINTF(dbgColor__dCyan, "mqttUrcHndlr() topic ptr=%p blkSz=%d \r", workPtr, topicLen);
-        ((mqttAppRecv_func)topicCtrl->appRecvDataCB)(dataCntxt, msgId, mqttMsgSegment_topic, workPtr, topicLen, false);
 
-        // forward topic extension
-        workPtr += topicLen + 1;
-        uint16_t extensionLen = strlen(workPtr);
-        if (extensionLen > 0)
+/**
+ *  @brief Background worker, recover lost connections for MQTT streams with auto-reconnect enabled.
+ */
+static void S__mqttDoWork()
+{
+    if (ATCMD_isLockActive())                                                               // busy, check back on next eventMgr() pass
+        return;
+
+    for (size_t i = 0; i < ltem__streamCnt; i++)
+    {
+        streamCtrl_t *streamCtrl = g_lqLTEM.streams[i];
+        if (streamCtrl != NULL && streamCtrl->streamType == streamType_MQTT && ((mqttCtrl_t*)streamCtrl)->autoReconnect)
         {
-            extensionLen -= 3;                                                              // remove topic(w/extension) and message body delimiter
-            PRINTF(dbgColor__dCyan, "mqttUrcHndlr() topicExt ptr=%p blkSz=%d \r", workPtr, extensionLen);
-            ((mqttAppRecv_func)topicCtrl->appRecvDataCB)(dataCntxt, msgId, mqttMsgSegment_topicExt, workPtr, extensionLen, false);
+            S__mqttRecover((mqttCtrl_t*)streamCtrl);
         }
+    }
+}
 
-        bool eomFound = false;
-        char* streamPtr;
-        uint16_t reqstBlockSz = cbffr_getCapacity(rxBffr) / 4;
-        do
+
+/**
+ *  @brief Auto-reconnect state machine: detect connection loss, schedule attempts with jittered exponential backoff, escalate.
+ */
+static void S__mqttRecover(mqttCtrl_t *mqttCtrl)
+{
+    if (mqttCtrl->recoverActive)                                                            // eventMgr() invoked during attempt
+        return;
+
+    if (mqttCtrl->recoverStage == mqttRecover_idle)
+    {
+        if (mqttCtrl->state == mqttState_connected)
+            return;
+
+        mqttCtrl->recoverStage = (mqttCtrl->state == mqttState_open) ? mqttRecover_reconnect : mqttRecover_reopen;
+        mqttCtrl->recoverAttempts = 0;
+        mqttCtrl->recoverModemResets = 0;
+        mqttCtrl->recoverBackoffMs = mqtt__recoverBackoffBaseMs;
+        mqttCtrl->recoverStartAt = pMillis();
+        mqttCtrl->recoverNextAt = mqttCtrl->recoverStartAt;                                 // first attempt immediately
+        mqttCtrl->statsDisconnects++;
+        PRINTF(dbgColor__warn, "MQTT(%d) connection lost, state=%d err=%d\r", mqttCtrl->dataCntxt, mqttCtrl->state, mqttCtrl->errCode);
+    }
+    if ((int32_t)(pMillis() - mqttCtrl->recoverNextAt) < 0)                                 // backoff period
+        return;
+
+    mqttCtrl->recoverActive = true;
+    resultCode_t rslt = S__mqttRecoverAttempt(mqttCtrl);
+    mqttCtrl->recoverActive = false;
+
+    if (rslt == resultCode__success)
+    {
+        mqttCtrl->statsRecoveries++;
+        mqttCtrl->statsRecoverLastMs = pMillis() - mqttCtrl->recoverStartAt;
+        mqttCtrl->statsRecoverMaxMs = MAX(mqttCtrl->statsRecoverMaxMs, mqttCtrl->statsRecoverLastMs);
+        mqttCtrl->statsRecoverLastStage = mqttCtrl->recoverStage;
+        mqttCtrl->recoverStage = mqttRecover_idle;
+        PRINTF(dbgColor__green, "MQTT(%d) recovered, stage=%d duration=%d\r", mqttCtrl->dataCntxt, mqttCtrl->statsRecoverLastStage, mqttCtrl->statsRecoverLastMs);
+        return;
+    }
+
+    if (mqttCtrl->recoverStage == mqttRecover_modemReset)                                    // BGx was reset, start over at reopen
+    {
+        mqttCtrl->recoverStage = mqttRecover_reopen;
+        mqttCtrl->recoverAttempts = 0;
+    }
+    else if (++mqttCtrl->recoverAttempts >= mqtt__recoverStageAttempts &&
+             (mqttCtrl->recoverStage < mqttRecover_pdpReactivate || mqttCtrl->recoverModemResets < mqtt__recoverModemResetMax))
+    {
+        mqttCtrl->recoverStage++;                                                           // escalate
+        mqttCtrl->recoverAttempts = 0;
+    }
+    // equal jitter: half of backoff fixed, half random; spreads reconnects of a device fleet after a network event
+    uint32_t jitterMs = ((uint32_t)rand() ^ pMillis()) % (mqttCtrl->recoverBackoffMs / 2 + 1);
+    mqttCtrl->recoverNextAt = pMillis() + mqttCtrl->recoverBackoffMs / 2 + jitterMs;
+    mqttCtrl->recoverBackoffMs = MIN(mqttCtrl->recoverBackoffMs * 2, mqtt__recoverBackoffMaxMs);
+    PRINTF(dbgColor__warn, "MQTT(%d) recover fail rslt=%d, next stage=%d in %dms\r", mqttCtrl->dataCntxt, rslt, mqttCtrl->recoverStage, mqttCtrl->recoverNextAt - pMillis());
+}
+
+
+/**
+ *  @brief Perform one recovery attempt at the current stage.
+ */
+static resultCode_t S__mqttRecoverAttempt(mqttCtrl_t *mqttCtrl)
+{
+    switch (mqttCtrl->recoverStage)
+    {
+        case mqttRecover_modemReset:
+            mqttCtrl->recoverModemResets++;
+            mqttCtrl->statsRecoverModemResets++;
+            ltem_start(resetAction_swReset);
+            S__mqttModemResetStreams();                                                     // BGx connection state lost with reset
+            break;
+
+        case mqttRecover_pdpReactivate:
+            mqtt_close(mqttCtrl);
+            ntwk_deactivateNetwork(g_lqLTEM.providerInfo->defaultContext);
+            ntwk_activateNetwork(g_lqLTEM.providerInfo->defaultContext);
+            break;
+
+        case mqttRecover_reopen:
+            mqtt_close(mqttCtrl);
+            break;
+
+        default:                                                                            // reconnect: use open connection if still open
+            break;
+    }
+
+    resultCode_t rslt = mqtt_open(mqttCtrl);
+    if (rslt == resultCode__success)
+        rslt = mqtt_connect(mqttCtrl, false);                                               // persistent session, server retains subscriptions
+    if (rslt == resultCode__success && !mqttCtrl->sessionPersisted)
+    {
+        rslt = S__topicResubscribe(mqttCtrl, mqttCtrl->topicRoot);                          // prior session was clean, subscriptions lost
+        mqttCtrl->sessionPersisted = (rslt == resultCode__success);
+    }
+    return rslt;
+}
+
+
+/**
+ *  @brief Mark all streams closed following a BGx reset by recovery; other MQTT connections recover on their own if enabled.
+ */
+static void S__mqttModemResetStreams()
+{
+    for (size_t i = 0; i < ltem__streamCnt; i++)
+    {
+        streamCtrl_t *streamCtrl = g_lqLTEM.streams[i];
+        if (streamCtrl == NULL)
+            continue;
+
+        if (streamCtrl->streamType == streamType_MQTT)
+        {
+            ((mqttCtrl_t*)streamCtrl)->state = mqttState_closed;
+        }
+        else if (streamCtrl->streamType == streamType_UDP || streamCtrl->streamType == streamType_TCP || streamCtrl->streamType == streamType_SSLTLS)
         {
-            uint16_t blockSz = cbffr_popBlock(rxBffr, &streamPtr, reqstBlockSz);
-            eomFound = lq_strnstr(streamPtr, "\"\r\n", blockSz) != NULL;
-            blockSz -= (eomFound) ? 3 : 0;                                                  // adjust blockSz to not include in app content
+            ((scktCtrl_t*)streamCtrl)->state = scktState_closed;                            // sckt_close() releases stream
+            ((scktCtrl_t*)streamCtrl)->dataPending = false;
+        }
+    }
+    PRINTF(dbgColor__warn, "MQTT recover BGx reset, streams closed\r");
+}
+
 
-            PRINTF(dbgColor__dCyan, "mqttUrcHndlr() msgBody ptr=%p blkSz=%d isFinal=%d\r", streamPtr, blockSz, eomFound);
+/**
+ *  @brief Deliver a topic segment in place from rxBffr to application (zero-copy), header content is already received.
+ */
+static void S__mqttDeliverSegment(cBuffer_t *rxBffr, mqttTopicCtrl_t *topicCtrl, dataCntxt_t dataCntxt, uint16_t msgId, mqttMsgSegment_t segment, uint16_t segmentSz)
+{
+    if (segmentSz == 0)                                                                     // topic always signaled (root '#' match)
+    {
+        ((mqttAppRecv_func)topicCtrl->appRecvDataCB)(dataCntxt, msgId, segment, NULL, 0, false);
+        return;
+    }
+    while (segmentSz > 0)
+    {
+        char* streamPtr;
+        uint16_t blockSz = cbffr_popBlock(rxBffr, &streamPtr, segmentSz);                  // contiguous block, 2 blocks if segment wraps rxBffr
+        PRINTF(dbgColor__dCyan, "mqttUrcHndlr() segment=%d ptr=%p blkSz=%d\r", segment, streamPtr, blockSz);
+        ((mqttAppRecv_func)topicCtrl->appRecvDataCB)(dataCntxt, msgId, segment, streamPtr, blockSz, false);
+        cbffr_popBlockFinalize(rxBffr, true);
+        segmentSz -= blockSz;
+    }
+}
+
+
+/**
+ *  @brief Count bits set in bitmap (buffer slot occupancy).
+ */
+static uint8_t S__bitCount(uint8_t bitmap)
+{
+    uint8_t cnt = 0;
+    for (; bitmap; bitmap >>= 1)
+        cnt += bitmap & 0x01;
+    return cnt;
+}
+
+
+/**
+ *  @brief Service async publish result URC: +QMTPUB: <tcpconnectID>,<msgID>,<result>[,<value>] (or +QMTPUBEX:)
+ *  @details Only the first MQTT URC in rxBffr is examined, its msgID is looked up in the in-flight table. While a command is
+ *           active a result is only taken if it is for an in-flight message and no command response precedes it, otherwise
+ *           it is left for the command parser (a blocking mqtt_publish() parses its own result).
+ *  @return True if URC was a publish result (serviced, or incomplete and will be on next pass)
+ */
+static bool S__mqttPublishUrc(cBuffer_t *rxBffr)
+{
+    int16_t urcIndx = cbffr_find(rxBffr, "+QMT", 0, 0, false);
+    if (CBFFR_NOTFOUND(urcIndx) || cbffr_find(rxBffr, "+QMTPUB", urcIndx, 7, false) != urcIndx)      // first MQTT URC is not a publish result
+        return false;
+    if (ATCMD_isLockActive() && (urcIndx > 2 || !S__mqttIsInflightAck(rxBffr, urcIndx)))            // 2 = leading line-end
+        return false;
+
+    char workBffr[48] = {0};
+    int16_t eolIndx = cbffr_find(rxBffr, "\r\n", urcIndx, sizeof(workBffr) - 1, false);
+    if (CBFFR_NOTFOUND(eolIndx))
+        return true;                                                                        // don't have full URC line yet, come back later
+
+    cbffr_skipTail(rxBffr, urcIndx);
+    cbffr_pop(rxBffr, workBffr, eolIndx - urcIndx + 2);
+    S__mqttPublishAck(workBffr);
+    return true;
+}
 
-            // signal new receive data available to host application
-            ((mqttAppRecv_func)topicCtrl->appRecvDataCB)(dataCntxt, msgId, mqttMsgSegment_msgBody, streamPtr, blockSz, eomFound);
 
-            cbffr_popBlockFinalize(g_lqLTEM.iop->rxBffr, true);                             // commit POP
-        } while (!eomFound);
+/**
+ *  @brief Test if publish result URC at urcIndx in rxBffr is for an in-flight message (matched in place, nothing consumed).
+ */
+static bool S__mqttIsInflightAck(cBuffer_t *rxBffr, uint16_t urcIndx)
+{
+    for (size_t i = 0; i < ltem__streamCnt; i++)
+    {
+        mqttCtrl_t *mqttCtrl = (mqttCtrl_t*)g_lqLTEM.streams[i];
+        if (mqttCtrl == NULL || mqttCtrl->streamType != streamType_MQTT || mqttCtrl->inflightCnt == 0)
+            continue;
+
+        for (size_t j = 0; j < mqtt__inflightCnt; j++)
+        {
+            if (mqttCtrl->inflight[j].msgId == 0)
+                continue;
+
+            char urcPrefix[24] = {0};
+            snprintf(urcPrefix, sizeof(urcPrefix), "+QMTPUB: %d,%d,", mqttCtrl->dataCntxt, mqttCtrl->inflight[j].msgId);
+            if (cbffr_find(rxBffr, urcPrefix, urcIndx, strlen(urcPrefix), false) == urcIndx)
+                return true;
+            snprintf(urcPrefix, sizeof(urcPrefix), "+QMTPUBEX: %d,%d,", mqttCtrl->dataCntxt, mqttCtrl->inflight[j].msgId);
+            if (cbffr_find(rxBffr, urcPrefix, urcIndx, strlen(urcPrefix), false) == urcIndx)
+                return true;
+        }
     }
+    return false;
+}
 
-    /* MQTT Status Change
-     * ------------------------------------------------------------------------------------- */
-    else if (CBFFR_FOUND(cbffr_find(rxBffr, "+QMTSTAT", 0, 20, true)))                      // MQTT connection closed
+
+/**
+ *  @brief Apply a publish result line to the in-flight message with its msgID; results for unknown messages are discarded.
+ *  @param ackLine [in] Result line, starting at +QMTPUB: or +QMTPUBEX:
+ */
+static void S__mqttPublishAck(const char *ackLine)
+{
+    char *workPtr = strchr(ackLine, ':') + 1;
+    uint8_t dataCntxt = strtol(workPtr, &workPtr, 10);
+    uint16_t msgId = strtol(workPtr + 1, &workPtr, 10);
+    uint8_t result = strtol(workPtr + 1, NULL, 10);
+
+    mqttCtrl_t *mqttCtrl = (mqttCtrl_t*)ltem_getStreamFromCntxt(dataCntxt, streamType_MQTT);
+    mqttInflight_t *inflight = NULL;
+    for (size_t i = 0; mqttCtrl != NULL && i < mqtt__inflightCnt; i++)
     {
-        uint16_t eopUrl = cbffr_find(rxBffr, "\r\n", 0, 0, false);
-        if (CBFFR_FOUND(eopUrl))
+        if (mqttCtrl->inflight[i].msgId == msgId)
         {
-            cbffr_pop(rxBffr, workBffr, eopUrl);
-            workPtr = lq_strnstr(workBffr, "+QMSTAT", sizeof(workBffr)) + 9;
+            inflight = &mqttCtrl->inflight[i];
+            break;
+        }
+    }
+    if (inflight == NULL)                                                                   // expired or not async, nothing to complete
+    {
+        PRINTF(dbgColor__warn, "MQTT-PUB result discarded cntxt=%d msgId=%d\r", dataCntxt, msgId);
+        return;
+    }
 
-            uint8_t cntxt = strtol(workPtr, &workPtr, 10);
-            workPtr++;
+    if (result == mqttResult_retransmission)                                                // BGx retransmitting, final result follows
+    {
+        inflight->retransmits++;
+        mqttCtrl->statsRetransmits++;
+    }
+    else
+    {
+        S__mqttPublishComplete(mqttCtrl, inflight, (result == mqttResult_success) ? mqttResult_success : mqttResult_failed);
+    }
+}
 
-            streamCtrl_t* streamCtrl = ltem_getStreamFromCntxt(cntxt, streamType_MQTT);
-            ASSERT(streamCtrl != NULL);
-            ((mqttCtrl_t*)streamCtrl)->errCode = strtol(workPtr, NULL, 10);
-            ((mqttCtrl_t*)streamCtrl)->state = mqttState_closed;
+
+/**
+ *  @brief Complete an async publish: release in-flight entry, update stats and signal application.
+ */
+static void S__mqttPublishComplete(mqttCtrl_t *mqttCtrl, mqttInflight_t *inflight, mqttResult_t result)
+{
+    uint16_t msgId = inflight->msgId;
+    mqttPublishDone_func doneCB = inflight->doneCB;
+
+    if (result == mqttResult_success)
+    {
+        mqttCtrl->statsPublished++;
+        mqttCtrl->statsPublishLatencyMs = pMillis() - inflight->sentAt;
+    }
+    else
+    {
+        mqttCtrl->statsPublishFails++;
+    }
+    inflight->msgId = 0;                                                                    // release entry before callback, app may publish from callback
+    mqttCtrl->inflightCnt--;
+
+    PRINTF(dbgColor__dYellow, "MQTT-PUB complete msgId=%d result=%d\r", msgId, result);
+    if (doneCB != NULL)
+    {
+        (*doneCB)(mqttCtrl->dataCntxt, msgId, result);
+    }
+}
+
+
+/**
+ *  @brief Fail in-flight publishes without a BGx result within the publish timeout.
+ */
+static void S__mqttExpireInflight(mqttCtrl_t *mqttCtrl)
+{
+    for (size_t i = 0; i < mqtt__inflightCnt; i++)
+    {
+        if (mqttCtrl->inflight[i].msgId != 0 && pElapsed(mqttCtrl->inflight[i].sentAt, mqtt__publishTimeout))
+        {
+            S__mqttPublishComplete(mqttCtrl, &mqttCtrl->inflight[i], mqttResult_failed);
         }
     }
 }
@@ -747,7 +1602,85 @@ static cmdParseRslt_t S__mqttSubscribeCompleteParser()
  */
 static cmdParseRslt_t S__mqttPublishCompleteParser() 
 {
-    return atcmd_stdResponseParser("+QMTPUB: ", true, ",", 0, 2, "", 0);
+    // +QMTPUB: <tcpconnectID>,<msgID>,<result>[,<value>]
+    return atcmd_stdResponseParser("+QMTPUB: ", true, ",", 0, 3, "\r\n", 0);
+}
+
+
+/**
+ *	@brief [private] MQTT inline publish (AT+QMTPUBEX) response parser.
+ *  @return LTEmC parse result
+ */
+static cmdParseRslt_t S__mqttPublishExCompleteParser() 
+{
+    // +QMTPUBEX: <tcpconnectID>,<msgID>,<result>[,<value>]
+    return atcmd_stdResponseParser("+QMTPUBEX: ", true, ",", 0, 3, "\r\n", 0);
+}
+
+
+/**
+ *	@brief [private] Data mode TX handler for producer publish, streams message chunks from alternating halves of the work
+ *         buffer: the next chunk is produced while the current chunk is transmitted by the IOP ISR.
+ */
+static resultCode_t S__mqttProducerTxDataHndlr()
+{
+    mqttCtrl_t *mqttCtrl = (mqttCtrl_t*)ltem_getStreamFromCntxt(g_lqLTEM.atcmd->dataMode.contextKey, streamType_MQTT);
+    ASSERT(mqttCtrl != NULL && mqttCtrl->txProducer != NULL);
+
+    uint16_t halfSz = g_lqLTEM.atcmd->dataMode.txDataSz / 2;
+    char *chunkPtr = g_lqLTEM.atcmd->dataMode.txDataLoc;
+    uint16_t chunkSz = (*mqttCtrl->txProducer)(mqttCtrl->dataCntxt, chunkPtr, MIN(halfSz, mqttCtrl->txRemaining));
+
+    while (mqttCtrl->txRemaining > 0)
+    {
+        if (chunkSz == 0 || chunkSz > mqttCtrl->txRemaining)                                   // producer failed to supply declared message size
+            return resultCode__badRequest;
+
+        IOP_startTx(chunkPtr, chunkSz);
+        mqttCtrl->txRemaining -= chunkSz;
+        mqttCtrl->txChunks++;
+
+        char *nextPtr = (chunkPtr == g_lqLTEM.atcmd->dataMode.txDataLoc) ? chunkPtr + halfSz : g_lqLTEM.atcmd->dataMode.txDataLoc;
+        uint16_t nextSz = 0;
+        if (mqttCtrl->txRemaining > 0)
+            nextSz = (*mqttCtrl->txProducer)(mqttCtrl->dataCntxt, nextPtr, MIN(halfSz, mqttCtrl->txRemaining));
+
+        if (!IOP_awaitTxIdle(g_lqLTEM.atcmd->timeout))                                         // IOP starts TX only from idle
+            return resultCode__timeout;
+        chunkPtr = nextPtr;
+        chunkSz = nextSz;
+    }
+
+    uint32_t startTime = pMillis();
+    while (pMillis() - startTime < g_lqLTEM.atcmd->timeout)                                    // BGx accepted message
+    {
+        if (CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "OK", 0, 0, true)))
+        {
+            cbffr_skipTail(g_lqLTEM.iop->rxBffr, 4);                                            // OK + line-end
+            return resultCode__success;
+        }
+        pDelay(1);
+    }
+    return resultCode__timeout;
+}
+
+
+/**
+ *	@brief [private] Test if message can be sent inline with AT+QMTPUBEX.
+ *  @details Inline message is a quoted command parameter: size limited by BGx and command buffer, printable chars only and
+ *           no double quote. Other messages use the AT+QMTPUB data prompt.
+ */
+static bool S__mqttPublishInlineEligible(const char *topic, const char *message, uint16_t messageSz)
+{
+    if (messageSz > mqtt__publishInlineMaxSz || strlen(topic) + messageSz + mqtt__publishInlineOvrhdSz >= atcmd__cmdBufferSz)
+        return false;
+
+    for (uint16_t i = 0; i < messageSz; i++)
+    {
+        if (message[i] < ' ' || message[i] > '~' || message[i] == '"')
+            return false;
+    }
+    return true;
 }
 
 
@@ -37,9 +37,20 @@ enum mqtt__constants
     mqtt__useTls = 1,
     mqtt__notUsingTls = 0,
     mqtt__publishTimeout = 15000,
+    mqtt__inflightCnt = 8,                                              /// max outstanding async (QOS1/QOS2) publishes, see mqtt_setPublishWindow()
+    mqtt__recvBufferSlots = 5,                                          /// BGx message buffer slots per client in buffered receive mode
+    mqtt__recvReadTimeoutMs = 5000,                                     /// max wait for message content following +QMTRECV header
+    mqtt__recvHeaderPrefixSz = 20,                                      /// max +QMTRECV header chars preceding topic: +QMTRECV: 5,65535,"
+    mqtt__publishMaxSz = 4096,                                          /// max message sent with AT+QMTPUB data prompt
+    mqtt__publishInlineMaxSz = 560,                                     /// max message sent inline with AT+QMTPUBEX (single round-trip publish)
+    mqtt__publishInlineOvrhdSz = 40,                                    /// AT+QMTPUBEX command chars excluding topic and message
+    mqtt__recoverBackoffBaseMs = 2000,                                  /// auto-reconnect: backoff after first failed attempt (doubles per failure)
+    mqtt__recoverBackoffMaxMs = 300000,                                 /// auto-reconnect: backoff limit
+    mqtt__recoverStageAttempts = 3,                                     /// auto-reconnect: failed attempts before escalating to next recovery stage
+    mqtt__recoverModemResetMax = 1,                                     /// auto-reconnect: BGx resets per connection loss, then PDP reactivation repeats
 
     mqtt__messageSz = 1548,                                             /// Maximum message size for BGx family (BG96, BG95, BG77)
-    mqtt__topicsCnt = 4,
+    mqtt__topicLevelSz = 40,                                            /// max chars in one topic filter level (between '/'), Azure device ID is 36
     mqtt__topic_offset = 24,
     mqtt__topic_nameSz = 90,                                            /// Azure IoTHub typically 50-70 chars
     mqtt__topic_propsSz = 320,                                          /// typically 250-300 bytes
@@ -127,6 +138,19 @@ typedef enum mqttState_tag
 } mqttState_t;
 
 
+/** 
+ *  @brief Auto-reconnect recovery stage, escalates as attempts at a stage fail.
+*/
+typedef enum mqttRecover_tag
+{
+    mqttRecover_idle = 0,           /// connected, no recovery in progress
+    mqttRecover_reconnect = 1,      /// MQTT open at BGx: connect (AT+QMTCONN)
+    mqttRecover_reopen = 2,         /// close/open/connect
+    mqttRecover_pdpReactivate = 3,  /// deactivate/activate PDP context, then reopen
+    mqttRecover_modemReset = 4      /// BGx reset, then reopen
+} mqttRecover_t;
+
+
 // /** 
 //  *  @brief Struct describing a MQTT topic subscription.
 // */
@@ -156,13 +180,69 @@ typedef enum mqttMsgSegment_tag
 */
 typedef struct mqttTopicCtrl_tag
 {
-    char topicName[PROPLEN(mqtt__topic_nameSz)];    /// Topic name. Note if the topic registered with '#' wildcard, this is removed from the topic name.
-    char wildcard;                                  /// Set to '#' if multilevel wildcard specified when subscribing to topic.
+    char topicName[PROPLEN(mqtt__topic_nameSz)];    /// Topic filter, including any '+' or '#' wildcards.
+    char wildcard;                                  /// Set to '#' if multilevel wildcard, '+' if single level wildcard(s) only, otherwise '\0'.
     uint8_t Qos;
     appRcvProto_func appRecvDataCB;                 /// callback into host application with data (cast from generic func* to stream specific function)
 } mqttTopicCtrl_t;
 
 
+/** 
+ *  @brief Subscription topic trie node, one per topic filter level. Nodes are supplied by the application (mqtt_setTopicPool).
+*/
+typedef struct mqttTopicNode_tag
+{
+    char level[mqtt__topicLevelSz];                 /// topic filter level name, "+" or "#"
+    struct mqttTopicNode_tag *child;                /// first node of next level
+    struct mqttTopicNode_tag *sibling;              /// next node at this level (free list link if not in use)
+    mqttTopicCtrl_t *topicCtrl;                     /// subscription with filter ending at this node, NULL if none
+} mqttTopicNode_t;
+
+
+/** 
+ *  @brief Callback function to signal completion of an async publish (mqtt_publishAsync).
+ *  @param dataCntxt The data context (MQTT connection) of the publish.
+ *  @param msgId MQTT ID of the message published.
+ *  @param result Success (may have required retransmission) or failed; failed includes no BGx result within publish timeout.
+ */
+typedef void (*mqttPublishDone_func)(dataCntxt_t dataCntxt, uint16_t msgId, mqttResult_t result);
+
+
+/** 
+ *  @brief Outstanding async publish, awaiting +QMTPUB result URC.
+*/
+typedef struct mqttInflight_tag
+{
+    uint16_t msgId;                                 /// message ID, 0 = entry available
+    uint32_t sentAt;                                /// tick count BGx accepted message
+    uint8_t retransmits;                            /// retransmission notifications (+QMTPUB result=1) received
+    mqttPublishDone_func doneCB;                    /// application completion callback (optional)
+} mqttInflight_t;
+
+
+/** 
+ *  @brief Callback function to produce message content for mqtt_publishFromProducer(). Invoked while the prior chunk is 
+ *         being sent, the producer must supply the full messageSz in total.
+ *  @param dataCntxt The data context (MQTT connection) publishing.
+ *  @param chunkBffr Buffer to fill with next chunk of message content.
+ *  @param chunkBffrSz Max chunk size, never more than remaining message content.
+ *  @return Number of chars placed in chunkBffr.
+ */
+typedef uint16_t (*mqttPublishProducer_func)(dataCntxt_t dataCntxt, char* chunkBffr, uint16_t chunkBffrSz);
+
+
+/** 
+ *  @brief Result of a producer publish (mqtt_publishFromProducer).
+*/
+typedef struct mqttPublishResult_tag
+{
+    uint32_t bytesSent;                         /// message chars sent to BGx
+    uint16_t chunks;                            /// producer chunks
+    uint32_t durationMs;                        /// elapsed time invoke to server result
+    uint32_t throughputBps;                     /// effective throughput (bytes/second)
+} mqttPublishResult_t;
+
+
 /** 
  *  @brief Struct representing the state of a MQTT stream service.
 */
@@ -179,14 +259,52 @@ typedef struct mqttCtrl_tag
     bool useTls;                                /// flag indicating SSL/TLS applied to stream
     char hostUrl[host__urlSz];                  /// URL or IP address of host
     uint16_t hostPort;                          /// IP port number host is listening on (allows for 65535/0)
-    mqttTopicCtrl_t* topics[mqtt__topicsCnt];   /// array of topic controls, provides for independent app receive functions per topic
+    mqttTopicNode_t *topicRoot;                 /// subscription topic trie, first node of top level; independent app receive functions per topic
+    mqttTopicNode_t *topicFree;                 /// available trie nodes from application supplied pool
     char clientId[PROPLEN(mqtt__clientIdSz)];   /// for auto-restart
     char username[PROPLEN(mqtt__userNameSz)];
     char password[PROPLEN(mqtt__userPasswordSz)];
     mqttVersion_t mqttVersion;
     uint16_t sentMsgId;                             /// MQTT TX message ID for QOS, automatically incremented, rolls at max value.
     uint16_t recvMsgId;                             /// last received message identifier
+    uint32_t statsRecvUnmatched;                    /// received messages discarded, topic matches no local subscription
     uint8_t errCode;
+
+    bool recvBuffered;                              /// BGx buffered receive mode, messages held at BGx until read (mqtt_fetchRecv)
+    uint8_t recvPending;                            /// buffered receive: bitmap of BGx buffer slots holding messages
+    uint8_t statsRecvBufferedPeak;                  /// buffered receive: max BGx buffer slots occupied
+
+    mqttInflight_t inflight[mqtt__inflightCnt];     /// outstanding async publishes
+    uint8_t inflightWindow;                         /// max outstanding async publishes (1 to mqtt__inflightCnt)
+    uint8_t inflightCnt;                            /// current outstanding async publishes
+    uint32_t statsPublished;                        /// async publishes completed successfully
+    uint32_t statsRetransmits;                      /// async publish retransmission notifications
+    uint32_t statsPublishFails;                     /// async publishes failed (BGx result or timeout)
+    uint32_t statsPublishLatencyMs;                 /// last async publish BGx accept to server acknowledge duration
+    uint32_t statsPublishInline;                    /// publishes sent inline (AT+QMTPUBEX), no data prompt turnaround
+    uint32_t statsPublishSyncMs;                    /// last mqtt_publish() duration, invoke to server result
+
+    struct mqttBatch_tag *batches;                  /// telemetry aggregation batches publishing on this connection (ltemc-mqttbatch)
+
+    mqttPublishProducer_func txProducer;            /// producer publish: message content source
+    uint16_t txRemaining;                           /// producer publish: message chars not yet produced
+    uint16_t txChunks;                              /// producer publish: chunks sent
+
+    bool autoReconnect;                             /// background recovery on connection loss (mqtt_setAutoReconnect)
+    bool sessionPersisted;                          /// server holds session (cleanSession=false), subscriptions survive reconnect
+    bool recoverActive;                             /// recovery attempt in progress (reentrancy guard)
+    mqttRecover_t recoverStage;                     /// current recovery stage
+    uint8_t recoverAttempts;                        /// failed attempts at current stage
+    uint32_t recoverBackoffMs;                      /// current backoff, jitter applied to next attempt
+    uint32_t recoverNextAt;                         /// tick count of next recovery attempt
+    uint32_t recoverStartAt;                        /// tick count connection loss detected
+    uint8_t recoverModemResets;                     /// BGx resets performed for current connection loss
+    uint32_t statsDisconnects;                      /// connection losses detected
+    uint32_t statsRecoverModemResets;               /// BGx resets performed by auto-reconnect
+    uint32_t statsRecoveries;                       /// connections restored by auto-reconnect
+    uint32_t statsRecoverLastMs;                    /// last time-to-recover (connection loss to connected)
+    uint32_t statsRecoverMaxMs;                     /// max time-to-recover
+    mqttRecover_t statsRecoverLastStage;            /// recovery stage that restored last connection
 } mqttCtrl_t;
 
 
@@ -197,7 +315,8 @@ typedef struct mqttCtrl_tag
  * 
  *  @details This func will be invoked multiple times (at least twice) to deliver received MQTT message data to the host
  *  application (app). The topic and msgBody will always be sent, the topicExtension (sometimes used for property pairs) may  
- *  be sent. IsFinal only applies to the msgBody part of the flow.
+ *  be sent. IsFinal only applies to the msgBody part of the flow. Topic parts are passed in place from the receive buffer, a
+ *  topic or topicExtension wrapping the end of the buffer arrives as 2 consecutive invocations for the same segment.
  *  =============================================================================================================================
  *  @param dataCntxt The data context receiving data.
  *  @param msgId MQTT ID of the message received.
@@ -224,11 +343,23 @@ extern "C"
 void mqtt_initControl(mqttCtrl_t *mqttCtrl, dataCntxt_t dataCntxt);
 
 
+/**
+ *  @brief Supply the node pool for the subscription topic trie. Required before subscribing to topics.
+ *  @details Each subscription uses one node per topic filter level not shared with another subscription's filter. Subscription 
+ *           count is limited only by the pool size. Message dispatch cost is proportional to topic depth, not subscription count.
+ *  @param mqttCtrl [in] Pointer to MQTT control structure.
+ *  @param topicNodes [in] Application array of trie nodes.
+ *  @param nodeCnt [in] Number of nodes in array.
+*/
+void mqtt_setTopicPool(mqttCtrl_t *mqttCtrl, mqttTopicNode_t *topicNodes, uint16_t nodeCnt);
+
+
 /**
  * @brief Initialize a (subscription) topic control structure
- * @details The topic control supports multilevel wildcards only, by suffixing your topic with /# the wildcard will be detected and 
- * handled during message receipt. The application receive function will be called multiple times per message, each invoke delivering
- * different parts of the incoming message.
+ * @details The topic filter supports MQTT wildcards: '+' matches a single level, a trailing '#' matches any number of levels 
+ * (including the parent level). Topics starting with '$' are not matched by a wildcard first level. The application receive 
+ * function will be called multiple times per message, each invoke delivering different parts of the incoming message. For a 
+ * '#' subscription the topic segment is the levels preceding the '#' and the remainder is delivered as the topic extension.
  * 
  * @param topicCtrl Pointer to the control to initialize
  * @param topic Topic name to subscribe to on the MQTT server
@@ -248,12 +379,25 @@ void mqtt_setConnection(mqttCtrl_t *mqttCtrl, const char *hostUrl, uint16_t host
  *  @brief Open a remote MQTT server for use.
  *
  *  @param [in] mqttCtrl MQTT stream control to operate with.
- *  @param [in] cleanSession 
+ *  @param [in] cleanSession False to have the server retain the session (subscriptions) across connection loss.
  *  @return A resultCode_t value indicating the success or type of failure.
 */
 resultCode_t mqtt_start(mqttCtrl_t *mqttCtrl, bool cleanSession);
 
 
+/**
+ *  @brief Enable background recovery of a lost server connection (+QMTSTAT or connect failure).
+ *  @details Recovery is performed by ltem_eventMgr() with jittered exponential backoff, escalating from connect to reopen to 
+ *           PDP context reactivation to BGx reset as attempts fail. A BGx reset is performed at most mqtt__recoverModemResetMax
+ *           times per connection loss, it closes all streams: other MQTT connections and sockets are marked closed (sockets
+ *           must be closed with sckt_close() before reopen). Recovery connects with a persistent session (cleanSession=false); 
+ *           topics are resubscribed only if the server does not hold the session.
+ *  @param [in] mqttCtrl MQTT stream control to operate with.
+ *  @param [in] enable Enable/disable auto-reconnect.
+*/
+void mqtt_setAutoReconnect(mqttCtrl_t *mqttCtrl, bool enable);
+
+
 /**
  *  @brief Open a remote MQTT server for use.
  *  @details The recommended approach is to use mqtt_start() and mqtt_reset() for server connections. The 
@@ -295,6 +439,8 @@ resultCode_t mqtt_cancelTopic(mqttCtrl_t *mqttCtrl, mqttTopicCtrl_t* topicCtrl);
 
 /**
  *  @brief Publish (send) a message to the MQTT server.
+ *  @details Messages up to mqtt__publishInlineMaxSz of printable chars (no double quote) are sent inline with AT+QMTPUBEX in a 
+ *           single command; other messages are sent following the AT+QMTPUB data prompt.
  * 
  *  @param mqttCtrl [in] Pointer to MQTT type stream control to operate on.
  *  @param topic The topic for the message being sent, the server will resend the msg to other clients subscribed to the topic.
@@ -302,11 +448,100 @@ resultCode_t mqtt_cancelTopic(mqttCtrl_t *mqttCtrl, mqttTopicCtrl_t* topicCtrl);
  *  @param message The message to send (< 4096 chars)
  *  @param messageSz Size of the message
  *  @param timeoutSec The number of seconds to wait for completion of the send operation.
- *  @return A resultCode_t value indicating the success or type of failure.
+ *  @return A resultCode_t value indicating the success or type of failure: conflict if the command lock is busy, gtwyTimeout
+ *          if the server reported the publish failed.
 */
 resultCode_t mqtt_publish(mqttCtrl_t *mqttCtrl, const char *topic, mqttQos_t qos, const char *message, uint16_t messageSz, uint8_t timeoutSec);
 
 
+/**
+ *  @brief Publish a message produced in chunks by an application callback; the message is not held in host memory.
+ *  @details The AT+QMTPUB data prompt transfer is fed from workBffr halves: the producer fills one half while the other is
+ *           transmitted. Host RAM required is workBffrSz, independent of the message size.
+ * 
+ *  @param mqttCtrl [in] Pointer to MQTT type stream control to operate on.
+ *  @param topic The topic for the message being sent.
+ *  @param qos The quality-of-service for this message.
+ *  @param messageSz Size of the message, 1 to mqtt__publishMaxSz; producer must supply exactly this many chars
+ *  @param producer Application callback producing message content.
+ *  @param workBffr Transfer buffer, split into two chunk buffers.
+ *  @param workBffrSz Size of workBffr.
+ *  @param publishResult [out] Optional (NULL) transfer statistics.
+ *  @return A resultCode_t value indicating the success or type of failure.
+*/
+resultCode_t mqtt_publishFromProducer(mqttCtrl_t *mqttCtrl, const char *topic, mqttQos_t qos, uint16_t messageSz, mqttPublishProducer_func producer, char *workBffr, uint16_t workBffrSz, mqttPublishResult_t *publishResult);
+
+
+/**
+ *  @brief Set BGx message receive mode, applied at open. Buffered mode holds received messages at the BGx, the URC signals only 
+ *         the buffer slot; messages are transferred to the host when the application calls mqtt_fetchRecv().
+ *  @details Buffered mode protects the LTEm RX buffer from a burst of incoming messages arriving while the host is busy. The 
+ *           BGx holds mqtt__recvBufferSlots messages per client.
+ *  @param mqttCtrl [in] Pointer to MQTT type stream control to operate on.
+ *  @param buffered [in] True for BGx buffered receive, false (default) for messages pushed inline with URC.
+*/
+void mqtt_setRecvBuffered(mqttCtrl_t *mqttCtrl, bool buffered);
+
+
+/**
+ *  @brief Get the number of messages held at the BGx (buffered receive mode), as signaled by URC.
+ *  @param mqttCtrl [in] Pointer to MQTT type stream control to operate on.
+ *  @return Count of BGx buffer slots holding messages.
+*/
+uint8_t mqtt_getRecvPendingCnt(mqttCtrl_t *mqttCtrl);
+
+
+/**
+ *  @brief Query the BGx for buffer occupancy (buffered receive mode), refreshes the pending count.
+ *  @param mqttCtrl [in] Pointer to MQTT type stream control to operate on.
+ *  @return Count of BGx buffer slots holding messages.
+*/
+uint8_t mqtt_fetchRecvStatus(mqttCtrl_t *mqttCtrl);
+
+
+/**
+ *  @brief Read one message held at the BGx (buffered receive mode), delivered to the application by its topic receive callback.
+ *  @param mqttCtrl [in] Pointer to MQTT type stream control to operate on.
+ *  @return A resultCode_t value; success = message delivered, notFound = no message pending.
+*/
+resultCode_t mqtt_fetchRecv(mqttCtrl_t *mqttCtrl);
+
+
+/**
+ *  @brief Set the number of async publishes that can be outstanding (awaiting server acknowledgement) at once.
+ *  @param mqttCtrl [in] Pointer to MQTT type stream control to operate on.
+ *  @param windowSz [in] Max outstanding publishes, 1 to mqtt__inflightCnt (default).
+*/
+void mqtt_setPublishWindow(mqttCtrl_t *mqttCtrl, uint8_t windowSz);
+
+
+/**
+ *  @brief Publish (send) a QOS1/QOS2 message without waiting for the server acknowledgement.
+ *  @details Returns once the BGx has accepted the message. The +QMTPUB result URC is matched by message ID to the in-flight 
+ *           table (serviced by ltem_eventMgr()) and doneCB is invoked on completion. If the publish window is full, waits 
+ *           (servicing URCs) for an outstanding publish to complete. Retransmission notifications are counted, the message 
+ *           remains outstanding until the final result.
+ * 
+ *  @param mqttCtrl [in] Pointer to MQTT type stream control to operate on.
+ *  @param topic The topic for the message being sent, the server will resend the msg to other clients subscribed to the topic.
+ *  @param qos The quality-of-service for this message, QOS1 or QOS2 (QOS0 has no acknowledgement, use mqtt_publish())
+ *  @param message The message to send (< 4096 chars)
+ *  @param messageSz Size of the message
+ *  @param doneCB Application callback for publish completion, can be NULL.
+ *  @return A resultCode_t value indicating the success or type of failure; success = message accepted by BGx.
+*/
+resultCode_t mqtt_publishAsync(mqttCtrl_t *mqttCtrl, const char *topic, mqttQos_t qos, const char *message, uint16_t messageSz, mqttPublishDone_func doneCB);
+
+
+/**
+ *  @brief Wait for all outstanding async publishes to complete.
+ *  @param mqttCtrl [in] Pointer to MQTT type stream control to operate on.
+ *  @param timeoutMS [in] Max time to wait.
+ *  @return A resultCode_t value, success if no publishes outstanding; otherwise timeout.
+*/
+resultCode_t mqtt_awaitPublishes(mqttCtrl_t *mqttCtrl, uint32_t timeoutMS);
+
+
 // /**
 //  *  @brief Publish (send) a message to the MQTT server.
 //  * 
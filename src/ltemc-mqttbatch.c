@@ -0,0 +1,223 @@
+/** ****************************************************************************
+  \file
+  \brief MQTT telemetry aggregation, samples batched into single publish messages
+  \author Greg Terrell, LooUQ Incorporated
+
+  \loouq
+
+--------------------------------------------------------------------------------
+
+    This project is released under the GPL-3.0 License.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+#define _DEBUG 0                        // set to non-zero value for PRINTF debugging output,
+// debugging output options             // LTEm1c will satisfy PRINTF references with empty definition if not already resolved
+#if _DEBUG > 0
+    asm(".global _printf_float");       // forces build to link in float support for printf
+    #if _DEBUG == 1
+    #define SERIAL_DBG 1                // enable serial port output using devl host platform serial, 1=wait for port
+    #elif _DEBUG == 2
+    #include <jlinkRtt.h>               // output debug PRINTF macros to J-Link RTT channel
+    #define PRINTF(c_,f_,__VA_ARGS__...) do { rtt_printf(c_, (f_), ## __VA_ARGS__); } while(0)
+    #endif
+#else
+#define PRINTF(c_, f_, ...)
+#endif
+
+#define SRCFILE "MQB"                           // create SRCFILE (3 char) MACRO for lq-diagnostics ASSERT
+#include "ltemc-internal.h"
+#include "ltemc-mqttbatch.h"
+
+extern ltemDevice_t g_lqLTEM;
+
+
+// file scope local function declarations
+static void S__batchDoWork();
+
+
+
+#pragma region public MQTT batch functions
+/* --------------------------------------------------------------------------------------------- */
+
+
+/**
+ *	@brief Initialize a telemetry batch for a topic and attach it to the MQTT connection.
+ */
+void mqttBatch_init(mqttBatch_t *batch, mqttCtrl_t *mqttCtrl, const char *topic, mqttQos_t qos, char *bffr, uint16_t bffrSz, uint32_t maxAgeMs)
+{
+    ASSERT(strlen(topic) < mqtt__topic_nameSz);
+    ASSERT(bffrSz > mqttBatch__recordHeaderSz && bffrSz <= mqtt__publishMaxSz);
+
+    memset(batch, 0, sizeof(mqttBatch_t));
+    batch->mqttCtrl = mqttCtrl;
+    strcpy(batch->topic, topic);
+    batch->qos = qos;
+    batch->bffr = bffr;
+    batch->bffrSz = bffrSz;
+    batch->maxAgeMs = maxAgeMs;
+
+    batch->next = mqttCtrl->batches;
+    mqttCtrl->batches = batch;
+    LTEM_registerDoWorker(S__batchDoWork);                                          // age flush is performed in background
+}
+
+
+/**
+ *	@brief Detach batch from MQTT connection.
+ */
+void mqttBatch_remove(mqttBatch_t *batch)
+{
+    for (mqttBatch_t **link = &batch->mqttCtrl->batches; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == batch)
+        {
+            *link = batch->next;
+            break;
+        }
+    }
+    batch->next = NULL;
+}
+
+
+/**
+ *	@brief Add a sample to the batch.
+ */
+resultCode_t mqttBatch_add(mqttBatch_t *batch, const char *sample, uint16_t sampleSz, mqttBatchPriority_t priority)
+{
+    ASSERT(sampleSz + mqttBatch__recordHeaderSz <= batch->bffrSz);                 // sample must fit an empty batch
+
+    if (batch->fillSz + mqttBatch__recordHeaderSz + sampleSz > batch->bffrSz)      // size flush
+    {
+        resultCode_t rslt = mqttBatch_flush(batch);
+        if (rslt != resultCode__success)
+            return rslt;                                                            // batch retained, sample not added
+    }
+
+    char *recordPtr = batch->bffr + batch->fillSz;
+    recordPtr[0] = sampleSz & 0xFF;
+    recordPtr[1] = sampleSz >> 8;
+    memcpy(recordPtr + mqttBatch__recordHeaderSz, sample, sampleSz);
+    batch->fillSz += mqttBatch__recordHeaderSz + sampleSz;
+    if (batch->sampleCnt++ == 0)
+        batch->firstSampleAt = pMillis();
+
+    if (priority == mqttBatchPriority_urgent)
+        return mqttBatch_flush(batch);
+    return resultCode__success;
+}
+
+
+/**
+ *	@brief Publish pending samples as a single message.
+ */
+resultCode_t mqttBatch_flush(mqttBatch_t *batch)
+{
+    if (batch->sampleCnt == 0)
+        return resultCode__success;
+
+    batch->flushing = true;
+    resultCode_t rslt = mqtt_publish(batch->mqttCtrl, batch->topic, batch->qos, batch->bffr, batch->fillSz, 0);
+    batch->flushing = false;
+
+    if (rslt != resultCode__success)
+    {
+        batch->statsFlushFails++;
+        return rslt;
+    }
+    batch->statsBatches++;
+    batch->statsBatchBytes += batch->fillSz;
+    batch->statsSamples += batch->sampleCnt;
+    batch->statsSampleBytes += batch->fillSz - batch->sampleCnt * mqttBatch__recordHeaderSz;
+    PRINTF(dbgColor__dYellow, "mqttBatch flush topic=%s samples=%d sz=%d\r", batch->topic, batch->sampleCnt, batch->fillSz);
+
+    batch->fillSz = 0;
+    batch->sampleCnt = 0;
+    return resultCode__success;
+}
+
+
+/**
+ *	@brief Get publish messages saved by batching.
+ */
+uint32_t mqttBatch_getMessagesSaved(mqttBatch_t *batch)
+{
+    return batch->statsSamples - batch->statsBatches;
+}
+
+
+/**
+ *	@brief Get estimated wire bytes saved by batching.
+ */
+uint32_t mqttBatch_getBytesSaved(mqttBatch_t *batch)
+{
+    uint32_t overheadSaved = mqttBatch_getMessagesSaved(batch) * (mqttBatch__publishOverheadSz + strlen(batch->topic));
+    uint32_t prefixesAdded = batch->statsSamples * mqttBatch__recordHeaderSz;
+    return (overheadSaved > prefixesAdded) ? overheadSaved - prefixesAdded : 0;
+}
+
+
+/**
+ *	@brief Get batching compression ratio (x100).
+ */
+uint16_t mqttBatch_getCompressionRatio(mqttBatch_t *batch)
+{
+    uint32_t perPublishSz = mqttBatch__publishOverheadSz + strlen(batch->topic);
+    uint32_t individualSz = batch->statsSampleBytes + batch->statsSamples * perPublishSz;
+    uint32_t batchedSz = batch->statsBatchBytes + batch->statsBatches * perPublishSz;
+    return (batchedSz > 0) ? (individualSz * 100) / batchedSz : 100;
+}
+
+
+#pragma endregion
+
+
+#pragma region Static Local Functions
+/* --------------------------------------------------------------------------------------------- */
+
+
+/**
+ *	@brief Background worker, publish batches whose oldest sample has reached the age limit.
+ */
+static void S__batchDoWork()
+{
+    if (ATCMD_isLockActive())                                                       // busy, check back on next eventMgr() pass
+        return;
+
+    for (size_t i = 0; i < ltem__streamCnt; i++)
+    {
+        streamCtrl_t *streamCtrl = g_lqLTEM.streams[i];
+        if (streamCtrl == NULL || streamCtrl->streamType != streamType_MQTT)
+            continue;
+
+        mqttCtrl_t *mqttCtrl = (mqttCtrl_t*)streamCtrl;
+        if (mqttCtrl->state != mqttState_connected)
+            continue;
+
+        for (mqttBatch_t *batch = mqttCtrl->batches; batch != NULL; batch = batch->next)
+        {
+            if (!batch->flushing && batch->sampleCnt > 0 && batch->maxAgeMs > 0 && pElapsed(batch->firstSampleAt, batch->maxAgeMs))
+            {
+                if (mqttBatch_flush(batch) != resultCode__success)
+                    batch->firstSampleAt = pMillis();                           // retry after another age period
+            }
+        }
+    }
+}
+
+
+#pragma endregion
@@ -0,0 +1,151 @@
+/** ****************************************************************************
+  \file
+  \author Greg Terrell, LooUQ Incorporated
+
+  \loouq
+
+--------------------------------------------------------------------------------
+
+    This project is released under the GPL-3.0 License.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+#ifndef __LTEMC_MQTTBATCH_H__
+#define __LTEMC_MQTTBATCH_H__
+
+#include <lq-types.h>
+#include "ltemc-types.h"
+#include "ltemc-mqtt.h"
+
+
+/**
+ *  @brief Typed numeric constants for MQTT telemetry batching
+ */
+enum mqttBatch__constants
+{
+    mqttBatch__recordHeaderSz = 2,              /// sample length prefix (uint16 LE)
+    mqttBatch__publishOverheadSz = 60           /// estimated wire bytes per publish excluding topic/payload: MQTT header, msgId, PUBACK, TCP/IP headers
+};
+
+
+/**
+ *  @brief Sample priority, urgent samples flush the batch immediately.
+*/
+typedef enum mqttBatchPriority_tag
+{
+    mqttBatchPriority_normal = 0,
+    mqttBatchPriority_urgent = 1
+} mqttBatchPriority_t;
+
+
+/**
+ *  @brief Telemetry batch for one topic. Samples are packed as length-prefixed records (uint16 LE length + sample) and
+ *         published as a single message when the buffer fills, the oldest sample reaches maxAgeMs or an urgent sample is added.
+*/
+typedef struct mqttBatch_tag
+{
+    mqttCtrl_t *mqttCtrl;                       /// MQTT connection batch is published to
+    struct mqttBatch_tag *next;                 /// next batch on connection (mqttCtrl->batches)
+    char topic[mqtt__topic_nameSz];
+    mqttQos_t qos;
+    char *bffr;                                 /// application supplied batch buffer, batch message size limit
+    uint16_t bffrSz;
+    uint16_t fillSz;                            /// bytes packed in bffr
+    uint16_t sampleCnt;                         /// samples packed in bffr
+    uint32_t firstSampleAt;                     /// tick count oldest sample in bffr was added
+    uint32_t maxAgeMs;                          /// age flush, 0 = size/priority flush only
+    bool flushing;                              /// publish in progress (reentrancy guard)
+    uint32_t statsSamples;                      /// samples published
+    uint32_t statsSampleBytes;                  /// sample content bytes published
+    uint32_t statsBatches;                      /// batch messages published
+    uint32_t statsBatchBytes;                   /// batch message bytes published (content + length prefixes)
+    uint32_t statsFlushFails;                   /// batch publish failures, batch retained for retry
+} mqttBatch_t;
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+
+/**
+ *	@brief Initialize a telemetry batch for a topic and attach it to the MQTT connection; aged batches are flushed by ltem_eventMgr().
+ *  @param batch [out] Pointer to batch structure
+ *  @param mqttCtrl [in] MQTT connection to publish batches to
+ *  @param topic [in] Topic batches are published to
+ *  @param qos [in] Batch publish QOS
+ *  @param bffr [in] Batch buffer, sets max batch message size (mqtt__publishMaxSz limit)
+ *  @param bffrSz [in] Size of bffr
+ *  @param maxAgeMs [in] Max time a sample is held before batch is published, 0 = no age limit
+ */
+void mqttBatch_init(mqttBatch_t *batch, mqttCtrl_t *mqttCtrl, const char *topic, mqttQos_t qos, char *bffr, uint16_t bffrSz, uint32_t maxAgeMs);
+
+
+/**
+ *	@brief Detach batch from MQTT connection, pending samples are discarded (flush first to publish).
+ *  @param batch [in] Pointer to batch structure
+ */
+void mqttBatch_remove(mqttBatch_t *batch);
+
+
+/**
+ *	@brief Add a sample to the batch; batch is published if sample does not fit or is urgent.
+ *  @param batch [in] Pointer to batch structure
+ *  @param sample [in] Sample content
+ *  @param sampleSz [in] Size of sample
+ *  @param priority [in] Urgent samples are published immediately with the batch
+ *  @return Result code similar to http status code, OK = 200; publish result if batch flushed
+ */
+resultCode_t mqttBatch_add(mqttBatch_t *batch, const char *sample, uint16_t sampleSz, mqttBatchPriority_t priority);
+
+
+/**
+ *	@brief Publish pending samples as a single message.
+ *  @param batch [in] Pointer to batch structure
+ *  @return Result code similar to http status code, OK = 200; on failure samples are retained
+ */
+resultCode_t mqttBatch_flush(mqttBatch_t *batch);
+
+
+/**
+ *	@brief Get publish messages saved by batching (samples published less batch messages).
+ *  @param batch [in] Pointer to batch structure
+ */
+uint32_t mqttBatch_getMessagesSaved(mqttBatch_t *batch);
+
+
+/**
+ *	@brief Get estimated wire bytes saved by batching: per message overhead and topic of the saved publishes, less the length
+ *         prefixes added.
+ *  @param batch [in] Pointer to batch structure
+ */
+uint32_t mqttBatch_getBytesSaved(mqttBatch_t *batch);
+
+
+/**
+ *	@brief Get batching compression ratio (x100): estimated wire bytes publishing samples individually / wire bytes as batches.
+ *  @param batch [in] Pointer to batch structure
+ */
+uint16_t mqttBatch_getCompressionRatio(mqttBatch_t *batch);
+
+
+#ifdef __cplusplus
+}
+#endif // !__cplusplus
+
+#endif  /* !__LTEMC_MQTTBATCH_H__ */
@@ -0,0 +1,426 @@
+/** ****************************************************************************
+  \file
+  \brief MQTT store-and-forward outbound queue, persisted in BGx file system
+  \author Greg Terrell, LooUQ Incorporated
+
+  \loouq
+
+--------------------------------------------------------------------------------
+
+    This project is released under the GPL-3.0 License.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+#define _DEBUG 0                        // set to non-zero value for PRINTF debugging output,
+// debugging output options             // LTEm1c will satisfy PRINTF references with empty definition if not already resolved
+#if _DEBUG > 0
+    asm(".global _printf_float");       // forces build to link in float support for printf
+    #if _DEBUG == 1
+    #define SERIAL_DBG 1                // enable serial port output using devl host platform serial, 1=wait for port
+    #elif _DEBUG == 2
+    #include <jlinkRtt.h>               // output debug PRINTF macros to J-Link RTT channel
+    #define PRINTF(c_,f_,__VA_ARGS__...) do { rtt_printf(c_, (f_), ## __VA_ARGS__); } while(0)
+    #endif
+#else
+#define PRINTF(c_, f_, ...)
+#endif
+
+#define SRCFILE "MQQ"                           // create SRCFILE (3 char) MACRO for lq-diagnostics ASSERT
+#include "ltemc-internal.h"
+#include "ltemc-mqttqueue.h"
+
+extern ltemDevice_t g_lqLTEM;
+
+
+// file scope local function declarations
+static resultCode_t S__queueReadAt(mqttQueue_t *queue, uint32_t offset, char *bffr, uint16_t readSz);
+static resultCode_t S__queueWriteAt(mqttQueue_t *queue, uint32_t offset, const char *data, uint16_t writeSz);
+static resultCode_t S__queueReadRecordHeader(mqttQueue_t *queue, uint32_t offset, mqttQos_t *qos, uint16_t *topicLen, uint16_t *messageSz);
+static resultCode_t S__queueSaveHeader(mqttQueue_t *queue);
+static resultCode_t S__queueReset(mqttQueue_t *queue);
+static resultCode_t S__queueCompact(mqttQueue_t *queue);
+static void S__queueDropOldest(mqttQueue_t *queue);
+
+
+
+#pragma region public MQTT queue functions
+/* --------------------------------------------------------------------------------------------- */
+
+
+/**
+ *	@brief Open (create or recover) a persistent MQTT outbound queue.
+ */
+resultCode_t mqttQueue_open(mqttQueue_t *queue, mqttCtrl_t *mqttCtrl, const char *filename, uint32_t maxFileSz, mqttQueueDrop_t dropPolicy, char *workBffr, uint16_t workBffrSz)
+{
+    ASSERT(strlen(filename) < file__filenameSz);
+    ASSERT(maxFileSz > mqttQueue__fileHeaderSz);
+
+    memset(queue, 0, sizeof(mqttQueue_t));
+    queue->mqttCtrl = mqttCtrl;
+    strcpy(queue->filename, filename);
+    queue->maxFileSz = maxFileSz;
+    queue->dropPolicy = dropPolicy;
+    queue->workBffr = workBffr;
+    queue->workBffrSz = workBffrSz;
+
+    resultCode_t rslt = file_open(filename, fileOpenMode_rdWr, &queue->fileHandle);     // opens existing or creates
+    if (rslt != resultCode__success)
+        return rslt;
+
+    uint32_t fileSz = 0;
+    if (file_seek(queue->fileHandle, 0, fileSeekMode_fromEnd) == resultCode__success)
+        file_getPosition(queue->fileHandle, &fileSz);
+
+    char fileHeader[mqttQueue__fileHeaderSz];
+    if (fileSz < mqttQueue__fileHeaderSz ||
+        S__queueReadAt(queue, 0, fileHeader, mqttQueue__fileHeaderSz) != resultCode__success ||
+        memcmp(fileHeader, "MQQ1", 4) != 0)
+    {
+        PRINTF(dbgColor__dYellow, "mqttQueue_open() new queue file=%s\r", filename);
+        return S__queueReset(queue);
+    }
+
+    // recover existing queue, scan log from oldest undelivered record
+    queue->readOffset = (uint8_t)fileHeader[4] | (uint8_t)fileHeader[5] << 8 | (uint32_t)(uint8_t)fileHeader[6] << 16 | (uint32_t)(uint8_t)fileHeader[7] << 24;
+    queue->writeOffset = queue->readOffset;
+    while (queue->writeOffset < fileSz)
+    {
+        mqttQos_t qos;
+        uint16_t topicLen, messageSz;
+        if (S__queueReadRecordHeader(queue, queue->writeOffset, &qos, &topicLen, &messageSz) != resultCode__success)
+            break;                                                                      // corrupt or oversized record, discarded with rest of log
+        uint32_t recordSz = mqttQueue__recordHeaderSz + topicLen + messageSz;
+        if (queue->writeOffset + recordSz > fileSz)                                     // partial record written at power loss
+            break;
+        queue->writeOffset += recordSz;
+        queue->depth++;
+    }
+    if (queue->writeOffset < fileSz)                                                    // discard incomplete tail
+    {
+        file_seek(queue->fileHandle, queue->writeOffset, fileSeekMode_fromBegin);
+        file_truncate(queue->fileHandle);
+    }
+    PRINTF(dbgColor__dYellow, "mqttQueue_open() recovered file=%s depth=%d\r", filename, queue->depth);
+    return resultCode__success;
+}
+
+
+/**
+ *	@brief Close the queue file, queued messages are retained.
+ */
+void mqttQueue_close(mqttQueue_t *queue)
+{
+    file_close(queue->fileHandle);
+}
+
+
+/**
+ *	@brief Publish a message: sent directly if connected and the queue is empty, otherwise queued.
+ */
+resultCode_t mqttQueue_publish(mqttQueue_t *queue, const char *topic, mqttQos_t qos, const char *message, uint16_t messageSz)
+{
+    if (queue->depth == 0 && queue->mqttCtrl->state == mqttState_connected)
+    {
+        if (mqtt_publish(queue->mqttCtrl, topic, qos, message, messageSz, 0) == resultCode__success)
+            return resultCode__success;
+    }
+    return mqttQueue_enqueue(queue, topic, qos, message, messageSz);
+}
+
+
+/**
+ *	@brief Append a message to the queue.
+ */
+resultCode_t mqttQueue_enqueue(mqttQueue_t *queue, const char *topic, mqttQos_t qos, const char *message, uint16_t messageSz)
+{
+    uint16_t topicLen = strlen(topic);
+    uint32_t recordSz = mqttQueue__recordHeaderSz + topicLen + messageSz;
+    ASSERT(recordSz + 1 <= queue->workBffrSz);                                      // drain/compaction transfer records through workBffr
+
+    if (queue->writeOffset + recordSz > queue->maxFileSz)                           // make room: reclaim delivered space, then drop policy
+    {
+        if (queue->dropPolicy == mqttQueueDrop_oldest)
+        {
+            while (queue->depth > 0 && mqttQueue__fileHeaderSz + (queue->writeOffset - queue->readOffset) + recordSz > queue->maxFileSz)
+            {
+                S__queueDropOldest(queue);
+            }
+        }
+        if (queue->depth == 0)
+            S__queueReset(queue);
+        else if (queue->readOffset > mqttQueue__fileHeaderSz)
+            S__queueCompact(queue);
+
+        if (queue->writeOffset + recordSz > queue->maxFileSz)
+        {
+            queue->statsDropped++;
+            PRINTF(dbgColor__warn, "mqttQueue_enqueue() full, message dropped\r");
+            return resultCode__tooManyRequests;
+        }
+    }
+
+    char recordHeader[mqttQueue__recordHeaderSz];
+    recordHeader[0] = mqttQueue__recordMarker;
+    recordHeader[1] = (char)qos;
+    recordHeader[2] = topicLen & 0xFF;
+    recordHeader[3] = topicLen >> 8;
+    recordHeader[4] = messageSz & 0xFF;
+    recordHeader[5] = messageSz >> 8;
+
+    resultCode_t rslt = S__queueWriteAt(queue, queue->writeOffset, recordHeader, mqttQueue__recordHeaderSz);
+    if (rslt == resultCode__success)
+        rslt = S__queueWriteAt(queue, queue->writeOffset + mqttQueue__recordHeaderSz, topic, topicLen);
+    if (rslt == resultCode__success)
+        rslt = S__queueWriteAt(queue, queue->writeOffset + mqttQueue__recordHeaderSz + topicLen, message, messageSz);
+    if (rslt != resultCode__success)
+        return rslt;
+
+    queue->writeOffset += recordSz;
+    queue->depth++;
+    queue->statsEnqueued++;
+    return resultCode__success;
+}
+
+
+/**
+ *	@brief Publish queued messages in order, using the MQTT async publish window.
+ */
+resultCode_t mqttQueue_drain(mqttQueue_t *queue, uint32_t timeoutMs)
+{
+    mqttCtrl_t *mqttCtrl = queue->mqttCtrl;
+    resultCode_t rslt = resultCode__success;
+    uint32_t drainStart = pMillis();
+
+    while (queue->depth > 0)
+    {
+        if (mqttCtrl->state != mqttState_connected)
+        {
+            rslt = resultCode__unavailable;
+            break;
+        }
+        if (pElapsed(drainStart, timeoutMs))
+        {
+            rslt = resultCode__timeout;
+            break;
+        }
+
+        // publish a window of records
+        uint32_t failsStart = mqttCtrl->statsPublishFails;
+        uint32_t batchOffset = queue->readOffset;
+        uint16_t batchCnt = 0;
+        while (batchCnt < mqttCtrl->inflightWindow && batchCnt < queue->depth)
+        {
+            mqttQos_t qos;
+            uint16_t topicLen, messageSz;
+            rslt = S__queueReadRecordHeader(queue, batchOffset, &qos, &topicLen, &messageSz);
+            if (rslt == resultCode__success)                                                // workBffr: topic \0 message
+                rslt = S__queueReadAt(queue, batchOffset + mqttQueue__recordHeaderSz, queue->workBffr, topicLen);
+            if (rslt == resultCode__success)
+                rslt = S__queueReadAt(queue, batchOffset + mqttQueue__recordHeaderSz + topicLen, queue->workBffr + topicLen + 1, messageSz);
+            if (rslt != resultCode__success)
+                break;
+            queue->workBffr[topicLen] = '\0';
+
+            if (qos == mqttQos_0)                                                           // no acknowledgement to track
+                rslt = mqtt_publish(mqttCtrl, queue->workBffr, qos, queue->workBffr + topicLen + 1, messageSz, 0);
+            else
+                rslt = mqtt_publishAsync(mqttCtrl, queue->workBffr, qos, queue->workBffr + topicLen + 1, messageSz, NULL);
+            if (rslt != resultCode__success)
+                break;
+
+            batchOffset += mqttQueue__recordHeaderSz + topicLen + messageSz;
+            batchCnt++;
+        }
+
+        // window acknowledged, remove from queue
+        if (mqtt_awaitPublishes(mqttCtrl, mqtt__publishTimeout) != resultCode__success || mqttCtrl->statsPublishFails != failsStart)
+            rslt = resultCode__unavailable;
+        if (rslt != resultCode__success)
+            break;
+
+        queue->readOffset = batchOffset;
+        queue->depth -= batchCnt;
+        queue->statsDrained += batchCnt;
+        if (queue->depth > 0)
+            S__queueSaveHeader(queue);
+    }
+
+    if (queue->depth == 0 && queue->writeOffset > mqttQueue__fileHeaderSz)
+        S__queueReset(queue);
+
+    queue->statsDrainDurationMs = pMillis() - drainStart;
+    PRINTF(dbgColor__dYellow, "mqttQueue_drain() rslt=%d depth=%d duration=%d\r", rslt, queue->depth, queue->statsDrainDurationMs);
+    return rslt;
+}
+
+
+/**
+ *	@brief Get the number of messages queued.
+ */
+uint16_t mqttQueue_getDepth(mqttQueue_t *queue)
+{
+    return queue->depth;
+}
+
+
+#pragma endregion
+
+
+#pragma region Static Local Functions
+/* --------------------------------------------------------------------------------------------- */
+
+
+static resultCode_t S__queueReadAt(mqttQueue_t *queue, uint32_t offset, char *bffr, uint16_t readSz)
+{
+    if (readSz == 0)
+        return resultCode__success;
+
+    resultCode_t rslt = file_seek(queue->fileHandle, offset, fileSeekMode_fromBegin);
+    if (rslt != resultCode__success)
+        return rslt;
+
+    uint16_t readCnt;
+    rslt = file_readBuffer(queue->fileHandle, bffr, readSz, &readCnt);
+    return (rslt == resultCode__success && readCnt != readSz) ? resultCode__notFound : rslt;
+}
+
+
+static resultCode_t S__queueWriteAt(mqttQueue_t *queue, uint32_t offset, const char *data, uint16_t writeSz)
+{
+    if (writeSz == 0)
+        return resultCode__success;
+
+    resultCode_t rslt = file_seek(queue->fileHandle, offset, fileSeekMode_fromBegin);
+    if (rslt != resultCode__success)
+        return rslt;
+
+    fileWriteResult_t writeResult;
+    rslt = file_write(queue->fileHandle, data, writeSz, &writeResult);
+    if (rslt == resultCode__success)
+        queue->statsFlashBytes += writeResult.writtenSz;
+    return rslt;
+}
+
+
+/**
+ *	@brief Read and validate a record header; a record that would not fit workBffr (written with a larger buffer, or corrupt) is invalid.
+ */
+static resultCode_t S__queueReadRecordHeader(mqttQueue_t *queue, uint32_t offset, mqttQos_t *qos, uint16_t *topicLen, uint16_t *messageSz)
+{
+    char recordHeader[mqttQueue__recordHeaderSz];
+
+    resultCode_t rslt = S__queueReadAt(queue, offset, recordHeader, mqttQueue__recordHeaderSz);
+    if (rslt != resultCode__success)
+        return rslt;
+    if (recordHeader[0] != mqttQueue__recordMarker)
+        return resultCode__internalError;
+
+    *qos = (mqttQos_t)recordHeader[1];
+    *topicLen = (uint8_t)recordHeader[2] | (uint8_t)recordHeader[3] << 8;
+    *messageSz = (uint8_t)recordHeader[4] | (uint8_t)recordHeader[5] << 8;
+    if ((uint32_t)mqttQueue__recordHeaderSz + *topicLen + *messageSz + 1 > queue->workBffrSz)     // drain/compaction transfer records through workBffr
+        return resultCode__internalError;
+    return resultCode__success;
+}
+
+
+/**
+ *	@brief Persist the read offset (oldest undelivered record) to the file header.
+ */
+static resultCode_t S__queueSaveHeader(mqttQueue_t *queue)
+{
+    char fileHeader[mqttQueue__fileHeaderSz] = { 'M', 'Q', 'Q', '1' };
+    fileHeader[4] = queue->readOffset & 0xFF;
+    fileHeader[5] = (queue->readOffset >> 8) & 0xFF;
+    fileHeader[6] = (queue->readOffset >> 16) & 0xFF;
+    fileHeader[7] = (queue->readOffset >> 24) & 0xFF;
+    return S__queueWriteAt(queue, 0, fileHeader, mqttQueue__fileHeaderSz);
+}
+
+
+/**
+ *	@brief Empty queue, truncate log to file header.
+ */
+static resultCode_t S__queueReset(mqttQueue_t *queue)
+{
+    queue->readOffset = mqttQueue__fileHeaderSz;
+    queue->writeOffset = mqttQueue__fileHeaderSz;
+    queue->depth = 0;
+
+    resultCode_t rslt = S__queueSaveHeader(queue);                                  // leaves file position at end of header
+    if (rslt == resultCode__success)
+        rslt = file_truncate(queue->fileHandle);
+    return rslt;
+}
+
+
+/**
+ *	@brief Move queued records to the front of the log, reclaiming delivered space.
+ *  @note Records are moved forward in place, the header is updated after the move. Power loss during compaction can lose
+ *        the queued messages.
+ */
+static resultCode_t S__queueCompact(mqttQueue_t *queue)
+{
+    uint32_t srcOffset = queue->readOffset;
+    uint32_t dstOffset = mqttQueue__fileHeaderSz;
+
+    for (uint16_t i = 0; i < queue->depth; i++)
+    {
+        mqttQos_t qos;
+        uint16_t topicLen, messageSz;
+        resultCode_t rslt = S__queueReadRecordHeader(queue, srcOffset, &qos, &topicLen, &messageSz);
+        uint32_t recordSz = mqttQueue__recordHeaderSz + topicLen + messageSz;                 // validated to fit workBffr
+        if (rslt == resultCode__success)
+            rslt = S__queueReadAt(queue, srcOffset, queue->workBffr, recordSz);
+        if (rslt == resultCode__success)
+            rslt = S__queueWriteAt(queue, dstOffset, queue->workBffr, recordSz);
+        if (rslt != resultCode__success)
+            return rslt;
+        srcOffset += recordSz;
+        dstOffset += recordSz;
+    }
+
+    queue->readOffset = mqttQueue__fileHeaderSz;
+    queue->writeOffset = dstOffset;
+    file_seek(queue->fileHandle, dstOffset, fileSeekMode_fromBegin);
+    file_truncate(queue->fileHandle);
+    PRINTF(dbgColor__dYellow, "mqttQueue compacted: depth=%d size=%d\r", queue->depth, dstOffset);
+    return S__queueSaveHeader(queue);
+}
+
+
+/**
+ *	@brief Discard oldest queued record (drop policy).
+ */
+static void S__queueDropOldest(mqttQueue_t *queue)
+{
+    mqttQos_t qos;
+    uint16_t topicLen, messageSz;
+    if (S__queueReadRecordHeader(queue, queue->readOffset, &qos, &topicLen, &messageSz) != resultCode__success)
+    {
+        queue->readOffset = queue->writeOffset;                                     // unreadable log, discard all
+        queue->statsDropped += queue->depth;
+        queue->depth = 0;
+        return;
+    }
+    queue->readOffset += mqttQueue__recordHeaderSz + topicLen + messageSz;
+    queue->depth--;
+    queue->statsDropped++;
+}
+
+
+#pragma endregion
@@ -0,0 +1,159 @@
+/** ****************************************************************************
+  \file
+  \author Greg Terrell, LooUQ Incorporated
+
+  \loouq
+
+--------------------------------------------------------------------------------
+
+    This project is released under the GPL-3.0 License.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+#ifndef __LTEMC_MQTTQUEUE_H__
+#define __LTEMC_MQTTQUEUE_H__
+
+#include <lq-types.h>
+#include "ltemc-types.h"
+#include "ltemc-mqtt.h"
+#include "ltemc-files.h"
+
+
+/**
+ *  @brief Typed numeric constants for the MQTT store-and-forward queue
+ */
+enum mqttQueue__constants
+{
+    mqttQueue__fileHeaderSz = 8,                /// "MQQ1" + read offset (uint32 LE)
+    mqttQueue__recordHeaderSz = 6,              /// 'Q' + qos + topic length (uint16 LE) + message length (uint16 LE)
+    mqttQueue__recordMarker = 'Q'
+};
+
+
+/**
+ *  @brief Action when an enqueue would exceed the queue file size limit.
+*/
+typedef enum mqttQueueDrop_tag
+{
+    mqttQueueDrop_newest = 0,                   /// new message is rejected
+    mqttQueueDrop_oldest = 1                    /// oldest queued messages are discarded to make room
+} mqttQueueDrop_t;
+
+
+/**
+ *  @brief MQTT outbound queue persisted in BGx file system (UFS) as an append-only log.
+ *  @details Records are appended at writeOffset; the file header holds the offset of the oldest undelivered record. Delivered
+ *           space is reclaimed when the queue empties (file truncated) or by compaction when the size limit is reached.
+*/
+typedef struct mqttQueue_tag
+{
+    mqttCtrl_t *mqttCtrl;                       /// MQTT connection messages are published to
+    char filename[file__filenameSz];            /// BGx UFS file hosting the queue
+    uint16_t fileHandle;
+    char *workBffr;                             /// application supplied buffer for record transfer
+    uint16_t workBffrSz;
+    uint32_t maxFileSz;                         /// queue file size limit (bytes)
+    mqttQueueDrop_t dropPolicy;
+    uint32_t readOffset;                        /// file offset of oldest queued record
+    uint32_t writeOffset;                       /// file offset for next record (end of log)
+    uint16_t depth;                             /// messages queued
+    uint32_t statsEnqueued;                     /// messages written to queue
+    uint32_t statsDrained;                      /// queued messages delivered
+    uint32_t statsDropped;                      /// messages lost to size limit (drop policy)
+    uint32_t statsFlashBytes;                   /// bytes written to BGx flash: records, header updates and compaction
+    uint32_t statsDrainDurationMs;              /// duration of last drain (mqttQueue_drain)
+} mqttQueue_t;
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+
+/**
+ *	@brief Open (create or recover) a persistent MQTT outbound queue.
+ *  @details An existing queue file is recovered: messages queued prior to a restart are retained. The log is discarded from 
+ *           the first partially written or corrupt record, including a record too large for workBffr.
+ *  @param queue [out] Pointer to queue structure
+ *  @param mqttCtrl [in] MQTT connection to publish queued messages to
+ *  @param filename [in] BGx UFS file name for the queue
+ *  @param maxFileSz [in] Queue file size limit (bytes)
+ *  @param dropPolicy [in] Action when limit is reached
+ *  @param workBffr [in] Buffer for record transfer, sized for largest record: header + topic + 1 + message
+ *  @param workBffrSz [in] Size of workBffr
+ *  @return Result code similar to http status code, OK = 200
+ */
+resultCode_t mqttQueue_open(mqttQueue_t *queue, mqttCtrl_t *mqttCtrl, const char *filename, uint32_t maxFileSz, mqttQueueDrop_t dropPolicy, char *workBffr, uint16_t workBffrSz);
+
+
+/**
+ *	@brief Close the queue file, queued messages are retained.
+ *  @param queue [in] Pointer to queue structure
+ */
+void mqttQueue_close(mqttQueue_t *queue);
+
+
+/**
+ *	@brief Publish a message: sent directly if connected and the queue is empty (preserves order), otherwise queued.
+ *  @details A failed direct publish is queued.
+ *  @param queue [in] Pointer to queue structure
+ *  @param topic [in] Message topic
+ *  @param qos [in] Message QOS
+ *  @param message [in] Message content
+ *  @param messageSz [in] Message size
+ *  @return Result code similar to http status code, OK = 200 (published or queued)
+ */
+resultCode_t mqttQueue_publish(mqttQueue_t *queue, const char *topic, mqttQos_t qos, const char *message, uint16_t messageSz);
+
+
+/**
+ *	@brief Append a message to the queue.
+ *  @param queue [in] Pointer to queue structure
+ *  @param topic [in] Message topic
+ *  @param qos [in] Message QOS
+ *  @param message [in] Message content
+ *  @param messageSz [in] Message size
+ *  @return Result code similar to http status code, OK = 200; tooManyRequests if rejected by drop policy
+ */
+resultCode_t mqttQueue_enqueue(mqttQueue_t *queue, const char *topic, mqttQos_t qos, const char *message, uint16_t messageSz);
+
+
+/**
+ *	@brief Publish queued messages in order, using the MQTT async publish window. Call after (re)connect.
+ *  @details Messages are removed from the queue once the server has acknowledged the publish window they were sent in. A
+ *           failure stops the drain with the unacknowledged messages still queued (at-least-once delivery).
+ *  @param queue [in] Pointer to queue structure
+ *  @param timeoutMs [in] Max time to drain, queue may be partially drained on return
+ *  @return Result code similar to http status code, OK = 200 (queue empty)
+ */
+resultCode_t mqttQueue_drain(mqttQueue_t *queue, uint32_t timeoutMs);
+
+
+/**
+ *	@brief Get the number of messages queued.
+ *  @param queue [in] Pointer to queue structure
+ *  @return Queue depth
+ */
+uint16_t mqttQueue_getDepth(mqttQueue_t *queue);
+
+
+#ifdef __cplusplus
+}
+#endif // !__cplusplus
+
+#endif  /* !__LTEMC_MQTTQUEUE_H__ */
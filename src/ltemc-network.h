@@ -88,6 +88,13 @@ providerInfo_t *ntwk_awaitProvider(uint16_t waitSec);
 // void ntwk_setProviderDefaultContext(uint8_t defaultContext);
 
 
+/**
+ *	@brief Activate PDP Context/APN.
+ *  @param [in] contextId The APN number to operate on.
+ */
+void ntwk_activateNetwork(uint8_t contextId);
+
+
 /**
  *	@brief Deactivate PDP Context/APN.
  *  @param [in] contextId The APN number to operate on.
@@ -50,21 +50,40 @@ extern ltemDevice_t g_lqLTEM;
 #define MAX(x, y) (((x) < (y)) ? (y) : (x))
 
 #define DETECT_STALL(tick, threshold)  if (pMillis() - tick > threshold) return resultCode__timeout
-#define ASSERT_NOTSTALLED(tick, threshold)  ASSERT(pMillis() - tick > threshold)
+#define ASSERT_NOTSTALLED(tick, threshold)  ASSERT(pMillis() - tick < threshold)
 
 
 
 // file scope local function declarations
 static resultCode_t S__scktTxDataHndlr();
-static void S__scktUrcHndlr();
+static resultCode_t S__scktUrcHndlr();
 static resultCode_t S__scktRxHndlr();
+static void S__scktDoWork();
+static void S__scktRequestRecv(scktCtrl_t *scktCtrl);
+static void S__scktDeliverData(scktCtrl_t *scktCtrl, char *dataPtr, uint16_t dataSz, bool isFinal);
+static resultCode_t S__scktStreamData(scktCtrl_t *scktCtrl, uint16_t dataSz);
+static bool S__scktInvokeOpen(scktCtrl_t *scktCtrl);
+static const char* S__scktHostAddr(scktCtrl_t *scktCtrl);
+static void S__scktOpenComplete(scktCtrl_t *scktCtrl, resultCode_t openResult);
+static void S__scktParseRemoteAddr(scktCtrl_t *scktCtrl, const char *addrPtr);
+static void S__scktIncomingUrc(char *urcPtr);
+static int32_t S__scktFlushRead(scktCtrl_t *scktCtrl, uint16_t readSz);
+static bool S__scktOpenUrc(cBuffer_t *rxBffr);
+static void S__scktOpenResponse();
+static void S__scktOpenUrcLine(const char *urcLine);
+static resultCode_t S__scktSendChunk(scktCtrl_t *scktCtrl, const char *chunk, uint16_t chunkSz);
+static resultCode_t S__scktChunkTxDataHndlr();
+static void S__scktSendResult(scktSendResult_t *sendResult, uint32_t bytesSent, uint16_t chunks, uint32_t startTime);
 
 static cmdParseRslt_t S__irdResponseHeaderParser();
+static cmdParseRslt_t S__irdQueryParser();
 static cmdParseRslt_t S__sslrecvResponseHeaderParser();
 static cmdParseRslt_t S__udptcpOpenCompleteParser(const char *response, char **endptr);
 static cmdParseRslt_t S__sslOpenCompleteParser(const char *response, char **endptr);
 static cmdParseRslt_t S__socketSendCompleteParser(const char *response, char **endptr);
-static cmdParseRslt_t S__socketStatusParser(const char *response, char **endptr);
+static cmdParseRslt_t S__transparentConnectParser();
+static cmdParseRslt_t S__socketStatusParser();
+static cmdParseRslt_t S__sslStatusParser();
 
 
 
@@ -89,8 +108,28 @@ void sckt_initControl(scktCtrl_t *scktCtrl, dataCntxt_t dataCntxt, streamType_t
     scktCtrl->statsRxCnt = 0;
     scktCtrl->statsTxCnt = 0;
     scktCtrl->appRecvDataCB = recvCallback;
+    scktCtrl->urcEvntHndlr = S__scktUrcHndlr;
+    scktCtrl->dataRxHndlr = S__scktRxHndlr;
 
-    g_lqLTEM.streams[dataCntxt] = (streamCtrl_t*)scktCtrl;
+    LTEM_registerDoWorker(S__scktDoWork);                                       // socket data retrieval (IRD/SSLRECV) is performed in background
+}
+
+
+/**
+ *	@brief Set an application supplied receive buffer, placing socket in pull-mode.
+ */
+void sckt_setRecvBuffer(scktCtrl_t *scktCtrl, char *recvBffr, uint16_t recvBffrSz)
+{
+    ASSERT(scktCtrl->state == scktState_closed);                                // buffer change not supported on open socket
+    ASSERT(!scktCtrl->isService || recvBffr == NULL);                           // UDP service is push-mode only
+
+    if (recvBffr == NULL)
+    {
+        scktCtrl->recvBffr = NULL;
+        return;
+    }
+    cbffr_init(&scktCtrl->recvBffrCtrl, recvBffr, recvBffrSz);
+    scktCtrl->recvBffr = &scktCtrl->recvBffrCtrl;
 }
 
 
@@ -107,333 +146,1355 @@ void sckt_setConnection(scktCtrl_t *scktCtrl, uint8_t pdpCntxt, const char *host
 
 
 /**
- *	@brief Open a data connection (socket) to d data to an established endpoint via protocol used to open socket (TCP/UDP/TCP INCOMING).
+ *	@brief Set a UDP socket to service mode ("UDP SERVICE"); the socket is bound to a local port only.
+ */
+void sckt_setService(scktCtrl_t *scktCtrl, uint8_t pdpCntxt, uint16_t lclPort, scktAppRecvFrom_func recvFromCallback)
+{
+    ASSERT(scktCtrl->streamType == streamType_UDP);                             // BGx service mode supported for UDP
+    ASSERT(scktCtrl->state == scktState_closed);
+    ASSERT(recvFromCallback != NULL);
+
+    strcpy(scktCtrl->hostUrl, "127.0.0.1");                                     // BGx requires placeholder remote for service
+    scktCtrl->pdpCntxt = pdpCntxt;
+    scktCtrl->hostPort = 0;
+    scktCtrl->lclPort = lclPort;
+    scktCtrl->isService = true;
+    scktCtrl->isListener = false;
+    scktCtrl->appRecvFromCB = recvFromCallback;
+    scktCtrl->recvBffr = NULL;                                                  // push-mode only, datagram source reported per receive
+}
+
+
+/**
+ *	@brief Set a TCP socket to listener mode ("TCP LISTENER"), accepting incoming connections on a local port.
+ */
+void sckt_setListener(scktCtrl_t *scktCtrl, uint8_t pdpCntxt, uint16_t lclPort, scktAccept_func acceptCallback)
+{
+    ASSERT(scktCtrl->streamType == streamType_TCP);                             // BGx listener supported for TCP
+    ASSERT(scktCtrl->state == scktState_closed);
+    ASSERT(acceptCallback != NULL);
+
+    strcpy(scktCtrl->hostUrl, "127.0.0.1");                                     // BGx requires placeholder remote for listener
+    scktCtrl->pdpCntxt = pdpCntxt;
+    scktCtrl->hostPort = 0;
+    scktCtrl->lclPort = lclPort;
+    scktCtrl->isService = false;                                                // service IRD/recvFrom paths don't apply
+    scktCtrl->isListener = true;
+    scktCtrl->acceptCB = acceptCallback;
+}
+
+
+/**
+ *	@brief Get the number of open connections accepted by a TCP listener.
+ */
+uint8_t sckt_getConnectionCnt(scktCtrl_t *scktCtrl)
+{
+    uint8_t connCnt = 0;
+    for (uint8_t cntxt = 0; cntxt < dataCntxt__cnt; cntxt++)
+    {
+        scktCtrl_t *connCtrl = (scktCtrl_t*)ltem_getStreamFromCntxt(cntxt, streamType__SCKT);
+        if (connCtrl != NULL && connCtrl->listener == scktCtrl && connCtrl->state == scktState_open)
+            connCnt++;
+    }
+    return connCnt;
+}
+
+
+/**
+ *	@brief Set the BGx data access mode for a socket connection, applied at sckt_open().
+ */
+void sckt_setAccessMode(scktCtrl_t *scktCtrl, scktAccessMode_t accessMode)
+{
+    ASSERT(scktCtrl->state == scktState_closed);                                // access mode is set at open
+    scktCtrl->accessMode = accessMode;
+}
+
+
+/**
+ *	@brief Open a data connection (socket) to d data to an established endpoint via protocol used to open socket (TCP/UDP/TCP INCOMING).
+ */
+resultCode_t sckt_open(scktCtrl_t *scktCtrl, bool cleanSession)
+{
+    resultCode_t rslt = resultCode__badRequest;
+
+    scktCtrl->openStart = pMillis();
+    if (S__scktInvokeOpen(scktCtrl))
+    {
+        rslt = atcmd_awaitResultWithOptions(sckt__defaultOpenTimeoutMS, scktCtrl->useTls ? S__sslOpenCompleteParser : S__udptcpOpenCompleteParser);
+    }
+
+    if (rslt == resultCode__success)
+    {
+        S__scktOpenComplete(scktCtrl, resultCode__success);
+        ltem_addStream((streamCtrl_t*)scktCtrl);
+    }
+    return rslt;
+}
+
+
+/**
+ *	@brief Initiate a socket open without waiting for the connection; returns after BGx accepts the request (OK).
+ */
+resultCode_t sckt_openAsync(scktCtrl_t *scktCtrl)
+{
+    ASSERT(scktCtrl->state == scktState_closed);
+
+    scktCtrl->state = scktState_opening;
+    scktCtrl->openResult = resultCode__unknown;
+    scktCtrl->openStart = pMillis();
+    scktCtrl->openUnreported = true;
+    ltem_addStream((streamCtrl_t*)scktCtrl);                                    // URC handler locates opening socket by context
+
+    resultCode_t rslt = resultCode__conflict;
+    if (S__scktInvokeOpen(scktCtrl))
+    {
+        rslt = atcmd_awaitResult();                                             // OK: BGx accepted, result follows as URC
+        S__scktOpenResponse();                                                  // earlier async open result(s) received with OK
+    }
+    if (rslt != resultCode__success)
+    {
+        scktCtrl->state = scktState_closed;
+        scktCtrl->openUnreported = false;
+        ltem_deleteStream((streamCtrl_t*)scktCtrl);
+    }
+    return rslt;
+}
+
+
+/**
+ *	@brief Wait for any of a set of async opening sockets to complete (open or failed).
+ */
+int8_t sckt_awaitAnyOpen(scktCtrl_t *scktCtrls[], uint8_t scktCnt, uint32_t timeoutMS)
+{
+    uint32_t waitStart = pMillis();
+    do
+    {
+        ltem_eventMgr();                                                        // open results are delivered by URC
+        bool anyUnreported = false;
+        for (uint8_t i = 0; i < scktCnt; i++)
+        {
+            if (scktCtrls[i]->openUnreported && scktCtrls[i]->state != scktState_opening)
+            {
+                scktCtrls[i]->openUnreported = false;
+                return i;
+            }
+            anyUnreported |= scktCtrls[i]->openUnreported;
+        }
+        if (!anyUnreported)                                                     // no async open underway, nothing to wait for
+            return -1;
+        pYield();
+    } while (!pElapsed(waitStart, timeoutMS));
+    return -1;
+}
+
+
+/**
+ *	@brief Wait for all of a set of async opening sockets to complete (open or failed).
+ */
+resultCode_t sckt_awaitAllOpen(scktCtrl_t *scktCtrls[], uint8_t scktCnt, uint32_t timeoutMS)
+{
+    uint32_t waitStart = pMillis();
+    bool anyOpening;
+    do
+    {
+        ltem_eventMgr();                                                        // open results are delivered by URC
+        anyOpening = false;
+        for (uint8_t i = 0; i < scktCnt; i++)
+        {
+            anyOpening |= scktCtrls[i]->state == scktState_opening;
+        }
+        if (!anyOpening)
+            break;
+        pYield();
+    } while (!pElapsed(waitStart, timeoutMS));
+
+    PRINTF(dbgColor__cyan, "awaitAllOpen() cnt=%d %lums\r", scktCnt, pMillis() - waitStart);
+    if (anyOpening)
+        return resultCode__timeout;
+
+    for (uint8_t i = 0; i < scktCnt; i++)
+    {
+        scktCtrls[i]->openUnreported = false;                                   // all completions reported
+    }
+    for (uint8_t i = 0; i < scktCnt; i++)
+    {
+        if (scktCtrls[i]->state != scktState_open)
+            return scktCtrls[i]->openResult;
+    }
+    return resultCode__success;
+}
+
+
+
+/**
+ *	@brief Open a socket in transparent (passthrough) access mode; UART carries raw socket data in both directions.
+ */
+resultCode_t sckt_openTransparent(scktCtrl_t *scktCtrl)
+{
+    ASSERT(!g_lqLTEM.transparentMode);                                          // only one transparent session
+    ASSERT(scktCtrl->recvBffr == NULL);                                         // data is read directly from LTEm RX, not a socket buffer
+
+    uint8_t pdpCntxt = (scktCtrl->pdpCntxt == 0) ? g_lqLTEM.providerInfo->defaultContext : scktCtrl->pdpCntxt;
+    const char *hostAddr = S__scktHostAddr(scktCtrl);                          // resolve before command lock is taken
+    scktCtrl->accessMode = scktAccessMode_transparent;
+
+    if (!ATCMD_awaitLock(atcmd__defaultTimeout))                                // lock is held for the duration of transparent mode
+        return resultCode__conflict;
+
+    if (scktCtrl->useTls)
+        atcmd_invokeReuseLock("AT+QSSLOPEN=%d,%d,%d,\"%s\",%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->dataCntxt, hostAddr, scktCtrl->hostPort, scktAccessMode_transparent);
+    else
+        atcmd_invokeReuseLock("AT+QIOPEN=%d,%d,\"%s\",\"%s\",%d,%d,%d", pdpCntxt, scktCtrl->dataCntxt, (scktCtrl->streamType == streamType_UDP) ? "UDP" : "TCP", 
+                              hostAddr, scktCtrl->hostPort, scktCtrl->lclPort, scktAccessMode_transparent);
+
+    resultCode_t rslt = atcmd_awaitResultWithOptions(sckt__defaultOpenTimeoutMS, S__transparentConnectParser);
+    if (rslt != resultCode__success)
+    {
+        atcmd_close();
+        return rslt;
+    }
+
+    scktCtrl->state = scktState_open;
+    ltem_addStream((streamCtrl_t*)scktCtrl);
+    g_lqLTEM.transparentMode = true;                                            // eventMgr stands down, RX belongs to app
+    return resultCode__success;
+}
+
+
+/**
+ *	@brief Read raw received data from a socket in transparent mode (non-blocking).
+ */
+uint16_t sckt_transparentRead(scktCtrl_t *scktCtrl, char *recvBffr, uint16_t bffrSz)
+{
+    ASSERT(g_lqLTEM.transparentMode);
+
+    uint16_t readSz = MIN(bffrSz, cbffr_getOccupied(g_lqLTEM.iop->rxBffr));
+    if (readSz > 0)
+    {
+        cbffr_pop(g_lqLTEM.iop->rxBffr, recvBffr, readSz);
+        scktCtrl->statsRxCnt++;
+    }
+    return readSz;
+}
+
+
+/**
+ *	@brief Write raw data to a socket in transparent mode, returns after data is sent out UART to BGx.
+ */
+uint16_t sckt_transparentWrite(scktCtrl_t *scktCtrl, const char *data, uint16_t dataSz)
+{
+    ASSERT(g_lqLTEM.transparentMode);
+
+    if (!IOP_awaitTxIdle(sckt__transparentTxTimeoutMs))                         // IOP starts TX only from idle
+        return 0;
+    IOP_startTx(data, dataSz);                                                  // ISR despools from caller's buffer
+    if (!IOP_awaitTxIdle(sckt__transparentTxTimeoutMs))
+        return 0;
+
+    scktCtrl->statsTxCnt++;
+    return dataSz;
+}
+
+
+/**
+ *	@brief Exit transparent mode to command mode (guarded +++ escape), the socket connection remains open.
+ */
+resultCode_t sckt_exitTransparent(scktCtrl_t *scktCtrl)
+{
+    ASSERT(g_lqLTEM.transparentMode);
+
+    IOP_awaitTxIdle(sckt__transparentTxTimeoutMs);
+    atcmd_exitTransparentMode();                                                // +++ with guard times
+
+    uint32_t waitStart = pMillis();
+    while (CBFFR_NOTFOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "OK\r\n", 0, 0, true)))     // discards any data that preceeded OK
+    {
+        if (pElapsed(waitStart, sckt__transparentExitTimeoutMs))
+            return resultCode__timeout;                                         // still in transparent mode
+        pYield();
+    }
+    cbffr_skipTail(g_lqLTEM.iop->rxBffr, 4);                                    // OK + line-end
+
+    g_lqLTEM.transparentMode = false;
+    atcmd_close();                                                              // release lock held since open/resume
+    return resultCode__success;
+}
+
+
+/**
+ *	@brief Return a socket previously exited with sckt_exitTransparent() to transparent mode.
+ */
+resultCode_t sckt_resumeTransparent(scktCtrl_t *scktCtrl)
+{
+    ASSERT(!g_lqLTEM.transparentMode);
+    ASSERT(scktCtrl->accessMode == scktAccessMode_transparent);
+
+    if (!ATCMD_awaitLock(atcmd__defaultTimeout))
+        return resultCode__conflict;
+
+    if (scktCtrl->useTls)
+        atcmd_invokeReuseLock("ATO");                                           // SSL: return to data mode
+    else
+        atcmd_invokeReuseLock("AT+QISWTMD=%d,%d", scktCtrl->dataCntxt, scktAccessMode_transparent);
+
+    resultCode_t rslt = atcmd_awaitResultWithOptions(atcmd__defaultTimeout, S__transparentConnectParser);
+    if (rslt != resultCode__success)
+    {
+        atcmd_close();
+        return rslt;
+    }
+    g_lqLTEM.transparentMode = true;
+    return resultCode__success;
+}
+
+
+/**
+ *	@brief Close an established (open) connection socket
+ */
+void sckt_close(scktCtrl_t *scktCtrl)
+{
+    if (ltem_getStreamFromCntxt(scktCtrl->dataCntxt, streamType__SCKT) != (streamCtrl_t*)scktCtrl)    // not open (remote close still requires BGx close)
+        return;
+
+    if (scktCtrl->state == scktState_open)
+    {
+        sckt_flushTx(scktCtrl);                                                 // send pending coalesced writes
+    }
+    scktCtrl->txCoalescePending = 0;
+
+    if (scktCtrl->useTls)
+        atcmd_tryInvokeDefaults("AT+QSSLCLOSE=%d", scktCtrl->dataCntxt);        // BGx syntax different for SSL
+    else
+        atcmd_tryInvokeDefaults("AT+QICLOSE=%d", scktCtrl->dataCntxt);          // BGx syntax different for TCP/UDP
+    
+    if (atcmd_awaitResult() == resultCode__success)
+    {
+        scktCtrl->state = scktState_closed;
+        scktCtrl->dataPending = false;
+        ltem_deleteStream((streamCtrl_t*)scktCtrl);
+    }
+}
+
+
+/**
+ *	@brief Close an established (open) connection socket by context number.
+ *  @details This is provided for LTEm use in the case of a connection close/loss.
+ */
+void SCKT_closeCntxt(uint8_t cntxtNm)
+{
+    streamCtrl_t* streamCtrl = ltem_getStreamFromCntxt(cntxtNm, streamType__SCKT);
+    ASSERT(streamCtrl);
+
+    sckt_close(streamCtrl);
+}
+
+
+/**
+ *	@brief Drain the connection's receive data pipeline, discarding all data received and not yet read by the application.
+ */
+bool sckt_flush(scktCtrl_t *scktCtrl)
+{
+    if (ltem_getStreamFromCntxt(scktCtrl->dataCntxt, streamType__SCKT) != (streamCtrl_t*)scktCtrl)    // not open
+        return false;
+
+    uint32_t flushStart = pMillis();
+    scktCtrl->flushDiscarded = 0;
+
+    int32_t unreadSz = -1;                                                      // unknown: read until BGx reports empty
+    if (!scktCtrl->useTls && !scktCtrl->isService && !scktCtrl->isListener)     // UDP/TCP, query BGx unread length
+    {
+        if (!atcmd_tryInvoke("AT+QIRD=%d,0", scktCtrl->dataCntxt))
+            return false;
+        if (atcmd_awaitResultWithOptions(atcmd__defaultTimeout, S__irdQueryParser) != resultCode__success)
+            return false;
+        unreadSz = atcmd_getValue();
+    }
+
+    if (scktCtrl->recvBffr != NULL)                                             // pull-mode data not yet fetched by application
+    {
+        scktCtrl->flushDiscarded += cbffr_getOccupied(scktCtrl->recvBffr);
+        cbffr_reset(scktCtrl->recvBffr);
+    }
+
+    scktCtrl->flushing = true;                                                  // RX handler discards data, no application callbacks
+    bool flushed = true;
+    while (unreadSz != 0)
+    {
+        uint16_t readSz = (unreadSz > 0) ? MIN(unreadSz, sckt__irdRequestMaxSz) : sckt__irdRequestMaxSz;
+        int32_t readRslt = S__scktFlushRead(scktCtrl, readSz);
+        if (readRslt < 0)                                                       // command failed, leave remainder for next flush
+        {
+            flushed = false;
+            break;
+        }
+        if (readRslt == 0)
+            break;
+        if (unreadSz > 0)
+            unreadSz = (readRslt >= unreadSz) ? 0 : unreadSz - readRslt;
+    }
+    scktCtrl->flushing = false;
+    scktCtrl->dataPending = false;
+    scktCtrl->flushDuration = pMillis() - flushStart;
+    return flushed;
+}
+
+
+/**
+ *	@brief Cancel an active receive flow and discard any recieved bytes.
+ */
+void sckt_cancelRecv(scktCtrl_t *scktCtrl)
+{
+    sckt_flush(scktCtrl);
+}
+
+
+/**
+ *	@brief Retrieve the state of a socket connection
+ */
+bool sckt_getState(scktCtrl_t *scktCtrl)
+{
+    return scktCtrl->state;
+}
+
+
+/**
+ *	@brief Query the BGx for the connection state of a socket (QISTATE/QSSLSTATE).
+ */
+resultCode_t sckt_fetchStatus(scktCtrl_t *scktCtrl)
+{
+    bool invoked = scktCtrl->useTls ? atcmd_tryInvoke("AT+QSSLSTATE=%d", scktCtrl->dataCntxt) :
+                                      atcmd_tryInvoke("AT+QISTATE=1,%d", scktCtrl->dataCntxt);
+    if (!invoked)
+        return resultCode__conflict;
+
+    resultCode_t rslt = atcmd_awaitResultWithOptions(atcmd__defaultTimeout, scktCtrl->useTls ? S__sslStatusParser : S__socketStatusParser);
+    if (rslt == resultCode__success && atcmd_getValue() != 2)                   // socket_state 2 = connected
+    {
+        rslt = resultCode__unavailable;
+    }
+    if (rslt != resultCode__success && rslt != resultCode__timeout)
+    {
+        scktCtrl->state = scktState_closed;                                     // not connected at BGx, sckt_close() releases context
+    }
+    return rslt;
+}
+
+
+/**
+ *	@brief Get the number of received chars available to the application in the socket receive buffer (pull-mode).
+ */
+uint16_t sckt_available(scktCtrl_t *scktCtrl)
+{
+    if (scktCtrl->recvBffr == NULL)
+        return 0;
+    return cbffr_getOccupied(scktCtrl->recvBffr);
+}
+
+
+/**
+ *	@brief Send a buffer of any length, segmented into maximal QISEND/QSSLSEND chunks.
+ */
+resultCode_t sckt_sendLarge(scktCtrl_t *scktCtrl, const char *data, uint32_t dataSz, scktSendResult_t *sendResult)
+{
+    resultCode_t rslt = resultCode__success;
+    uint32_t startTime = pMillis();
+    uint32_t bytesSent = 0;
+    uint16_t chunks = 0;
+
+    scktCtrl->txProducer = NULL;                                                // data in memory, nothing to prepare during chunk sends
+    while (bytesSent < dataSz)
+    {
+        uint16_t chunkSz = MIN(dataSz - bytesSent, sckt__sendMaxSz);
+        rslt = S__scktSendChunk(scktCtrl, data + bytesSent, chunkSz);
+        if (rslt != resultCode__success)
+            break;
+        bytesSent += chunkSz;
+        chunks++;
+    }
+    S__scktSendResult(sendResult, bytesSent, chunks, startTime);
+    return rslt;
+}
+
+
+/**
+ *	@brief Send data produced by an application callback, segmented into maximal QISEND/QSSLSEND chunks.
+ */
+resultCode_t sckt_sendFromProducer(scktCtrl_t *scktCtrl, scktSendProducer_func producer, char *workBffr, uint16_t workBffrSz, scktSendResult_t *sendResult)
+{
+    ASSERT(producer != NULL && workBffr != NULL && workBffrSz >= 2);
+
+    resultCode_t rslt = resultCode__success;
+    uint32_t startTime = pMillis();
+    uint32_t bytesSent = 0;
+    uint16_t chunks = 0;
+
+    scktCtrl->txProducer = producer;
+    scktCtrl->txChunkSz = MIN(workBffrSz / 2, sckt__sendMaxSz);
+
+    char *chunkPtr = workBffr;
+    uint16_t chunkSz = (*producer)(scktCtrl->dataCntxt, chunkPtr, scktCtrl->txChunkSz);          // prime first chunk
+
+    while (chunkSz > 0)
+    {
+        scktCtrl->txNextPtr = (chunkPtr == workBffr) ? workBffr + scktCtrl->txChunkSz : workBffr;   // ping-pong halves
+        scktCtrl->txNextReady = false;
+
+        rslt = S__scktSendChunk(scktCtrl, chunkPtr, chunkSz);                   // TX handler produces next chunk while awaiting SEND OK
+        if (rslt != resultCode__success)
+            break;
+        bytesSent += chunkSz;
+        chunks++;
+
+        if (!scktCtrl->txNextReady)                                             // chunk completed before producer could be invoked
+        {
+            scktCtrl->txNextSz = (*producer)(scktCtrl->dataCntxt, scktCtrl->txNextPtr, scktCtrl->txChunkSz);
+        }
+        chunkPtr = scktCtrl->txNextPtr;
+        chunkSz = scktCtrl->txNextSz;
+    }
+    scktCtrl->txProducer = NULL;
+    S__scktSendResult(sendResult, bytesSent, chunks, startTime);
+    return rslt;
+}
+
+
+/**
+ *	@brief Fetch receive data by host application (pull-mode).
+ */
+uint16_t sckt_fetchRecv(scktCtrl_t *scktCtrl, char *recvBffr, uint16_t bffrSz)
+{
+    ASSERT(scktCtrl->recvBffr != NULL);                                         // socket must be in pull-mode
+
+    uint16_t fetchSz = MIN(bffrSz, cbffr_getOccupied(scktCtrl->recvBffr));
+    if (fetchSz > 0)
+    {
+        cbffr_pop(scktCtrl->recvBffr, recvBffr, fetchSz);                       // vacated space allows background worker to resume IRD/SSLRECV
+    }
+    return fetchSz;
+}
+
+
+/**
+ *	@brief Peek at receive data in place, without removing it from the socket receive buffer (pull-mode).
+ */
+uint16_t sckt_peek(scktCtrl_t *scktCtrl, char **peekPtr)
+{
+    ASSERT(scktCtrl->recvBffr != NULL);                                         // socket must be in pull-mode
+
+    *peekPtr = NULL;
+    uint16_t occupied = cbffr_getOccupied(scktCtrl->recvBffr);
+    if (occupied == 0)
+        return 0;
+
+    uint16_t blockSz = cbffr_popBlock(scktCtrl->recvBffr, peekPtr, occupied);
+    cbffr_popBlockFinalize(scktCtrl->recvBffr, false);                          // abandon POP, data remains in buffer
+    return blockSz;
+}
+
+
+/**
+ *	@brief Enable (or disable) send coalescing; small writes are combined and sent together on size or age threshold.
+ */
+void sckt_enableCoalescing(scktCtrl_t *scktCtrl, char *coalesceBffr, uint16_t bffrSz, uint16_t flushSz, uint32_t flushAgeMs)
+{
+    ASSERT(coalesceBffr == NULL || (flushSz > 0 && flushSz <= sckt__sendMaxSz && bffrSz >= flushSz));
+    ASSERT(scktCtrl->txCoalescePending == 0);                                   // flush before changing
+
+    scktCtrl->txCoalesceBffr = coalesceBffr;
+    scktCtrl->txCoalesceBffrSz = bffrSz;
+    scktCtrl->txFlushSz = flushSz;
+    scktCtrl->txFlushAgeMs = flushAgeMs;
+    scktCtrl->txCoalescePending = 0;
+}
+
+
+/**
+ *	@brief Write data to socket; coalesced with other writes if enabled, otherwise sent immediately (sckt_send).
+ */
+resultCode_t sckt_write(scktCtrl_t *scktCtrl, const char *data, uint16_t dataSz)
+{
+    if (scktCtrl->txCoalesceBffr == NULL)                                       // coalescing not enabled
+        return sckt_send(scktCtrl, data, dataSz);
+
+    resultCode_t rslt = resultCode__success;
+    if (scktCtrl->txCoalescePending + dataSz > scktCtrl->txFlushSz)             // won't fit with pending, send pending first
+    {
+        rslt = sckt_flushTx(scktCtrl);
+        if (rslt != resultCode__success)
+            return rslt;
+    }
+    if (dataSz >= scktCtrl->txFlushSz)                                          // large write, nothing to gain
+        return sckt_send(scktCtrl, data, dataSz);
+
+    if (scktCtrl->txCoalescePending == 0)
+        scktCtrl->txCoalesceStart = pMillis();
+    else
+        scktCtrl->statsTxCoalesced++;                                           // this write rides along with a pending send
+
+    memcpy(scktCtrl->txCoalesceBffr + scktCtrl->txCoalescePending, data, dataSz);
+    scktCtrl->txCoalescePending += dataSz;
+
+    if (scktCtrl->txCoalescePending >= scktCtrl->txFlushSz)
+        rslt = sckt_flushTx(scktCtrl);
+    return rslt;
+}
+
+
+/**
+ *	@brief Send any pending coalesced writes.
+ */
+resultCode_t sckt_flushTx(scktCtrl_t *scktCtrl)
+{
+    if (scktCtrl->txCoalescePending == 0)
+        return resultCode__success;
+
+    resultCode_t rslt = sckt_send(scktCtrl, scktCtrl->txCoalesceBffr, scktCtrl->txCoalescePending);
+    if (rslt == resultCode__success)                                            // on failure data is retained for retry
+    {
+        scktCtrl->txCoalescePending = 0;
+    }
+    return rslt;
+}
+
+
+/**
+ *	@brief Send data to an established endpoint via protocol used to open socket (TCP/UDP/TCP INCOMING).
+ */
+resultCode_t sckt_send(scktCtrl_t *scktCtrl, const char *data, uint16_t dataSz)
+{
+    resultCode_t rslt;
+
+    atcmd_configDataMode(scktCtrl->dataCntxt, "> ", atcmd_stdTxDataHndlr, data, dataSz, NULL, true);
+    atcmd_configDataModeEot(0x1A);
+
+    if (atcmd_tryInvoke("AT+QISEND=%d,%d", scktCtrl->dataCntxt, dataSz))
+    {
+        rslt = atcmd_awaitResultWithOptions(atcmd__defaultTimeout, S__socketSendCompleteParser);
+        if (rslt == resultCode__success)
+        {
+            scktCtrl->statsTxCnt++;
+        }
+        S__scktOpenResponse();
+    }
+    atcmd_close();
+    return rslt;                                                            // return sucess -OR- failure from sendRequest\sendRaw action
+}
+
+
+/**
+ *	@brief Send a datagram to a remote peer from a UDP service socket.
+ */
+resultCode_t sckt_sendTo(scktCtrl_t *scktCtrl, const char *remoteIp, uint16_t remotePort, const char *data, uint16_t dataSz)
+{
+    ASSERT(scktCtrl->isService && scktCtrl->streamType == streamType_UDP);
+    resultCode_t rslt = resultCode__conflict;
+
+    atcmd_configDataMode(scktCtrl->dataCntxt, "> ", atcmd_stdTxDataHndlr, data, dataSz, NULL, true);
+    atcmd_configDataModeEot(0x1A);
+
+    if (atcmd_tryInvoke("AT+QISEND=%d,%d,\"%s\",%d", scktCtrl->dataCntxt, dataSz, remoteIp, remotePort))
+    {
+        rslt = atcmd_awaitResultWithOptions(atcmd__defaultTimeout, S__socketSendCompleteParser);
+        if (rslt == resultCode__success)
+        {
+            scktCtrl->statsTxCnt++;
+        }
+        S__scktOpenResponse();
+    }
+    atcmd_close();
+    return rslt;
+}
+
+
+// static resultCode_t S__scktTxDataHndlr()
+// {
+//     IOP_startTx(g_lqLTEM.atcmd->dataMode.txDataLoc, g_lqLTEM.atcmd->dataMode.txDataSz);
+
+//     uint32_t startTime = pMillis();
+
+//     while (pMillis() - startTime < g_lqLTEM.atcmd->timeout)
+//     {
+//         if (CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "SEND OK", 0, 0, true)))
+//         {
+//             cbffr_skipTail(g_lqLTEM.iop->rxBffr, sizeof("SEND OK") + 1);
+//             return resultCode__success;
+//         }
+//         else if(CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "SEND FAIL", 0, 0, true)))
+//         {
+//             cbffr_skipTail(g_lqLTEM.iop->rxBffr, sizeof("SEND FAIL") + 1);
+//             return resultCode__tooManyRequests;
+//         }
+//         else if(CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "ERROR", 0, 0, true)))
+//         {
+//             cbffr_skipTail(g_lqLTEM.iop->rxBffr, sizeof("SEND FAIL") + 1);
+//             return resultCode__internalError;
+//         }
+
+//         pDelay(1);
+//     }
+//     return resultCode__timeout;
+// }
+
+
+#pragma region private local static functions
+/*-----------------------------------------------------------------------------------------------*/
+
+#define SCKT_URC_HEADERSZ 80                    // UDP service direct-push URC carries remote address
+
+/**
+ *   @brief Socket background worker; retrieves data reported by BGx "recv" URC with IRD/SSLRECV and sends aged coalesced writes.
+ *   @details Invoked by ltem_eventMgr(), commands are issued only when no AT command is underway. For pull-mode sockets, 
+ *            data is left in the BGx buffer until the application vacates space in the socket receive buffer.
+ */
+static void S__scktDoWork()
+{
+    if (ATCMD_isLockActive())                                               // busy, check back on next eventMgr() pass
+        return;
+
+    for (uint8_t cntxt = 0; cntxt < dataCntxt__cnt; cntxt++)
+    {
+        scktCtrl_t *scktCtrl = (scktCtrl_t*)ltem_getStreamFromCntxt(cntxt, streamType__SCKT);
+        if (scktCtrl == NULL)
+            continue;
+
+        if (scktCtrl->rejectPending)                                        // TCP listener: close incoming connections rejected by app
+        {
+            for (uint8_t connCntxt = 0; connCntxt < dataCntxt__cnt; connCntxt++)
+            {
+                if (scktCtrl->rejectPending & (1 << connCntxt) && atcmd_tryInvokeDefaults("AT+QICLOSE=%d", connCntxt))
+                {
+                    atcmd_awaitResult();
+                    scktCtrl->rejectPending &= ~(1 << connCntxt);
+                }
+            }
+        }
+        bool hasReceiver = scktCtrl->appRecvDataCB != NULL || scktCtrl->appRecvFromCB != NULL || scktCtrl->recvBffr != NULL;
+        if (scktCtrl->dataPending && hasReceiver)                           // no receiver (idle pooled): data held at BGx
+        {
+            S__scktRequestRecv(scktCtrl);
+        }
+        if (scktCtrl->txCoalescePending > 0 && scktCtrl->state == scktState_open && pElapsed(scktCtrl->txCoalesceStart, scktCtrl->txFlushAgeMs))
+        {
+            sckt_flushTx(scktCtrl);
+        }
+    }
+}
+
+
+/**
+ *   @brief Request socket data from BGx (IRD/SSLRECV), sized to fit available LTEm and socket receive buffer space.
+ */
+static void S__scktRequestRecv(scktCtrl_t *scktCtrl)
+{
+    if (scktCtrl->isService)                                                // UDP service: IRD without length reads one datagram w/ source address
+    {
+        if (cbffr_getVacant(g_lqLTEM.iop->rxBffr) < sckt__irdRequestPageSz)
+            return;
+        atcmd_configDataMode(scktCtrl->dataCntxt, "+QIRD: ", S__scktRxHndlr, NULL, 0, scktCtrl->appRecvDataCB, true);
+        if (atcmd_tryInvoke("AT+QIRD=%d", scktCtrl->dataCntxt) && atcmd_awaitResult() == resultCode__success)
+        {
+            scktCtrl->dataPending = atcmd_getValue() > 0;                   // continue until BGx reports no datagram (read size=0)
+        }
+        return;
+    }
+
+    uint16_t rqstSz = MIN(cbffr_getVacant(g_lqLTEM.iop->rxBffr) / 2, sckt__irdRequestMaxSz);     // request up to half of available buffer space
+    if (scktCtrl->recvBffr != NULL)
+    {
+        rqstSz = MIN(rqstSz, cbffr_getVacant(scktCtrl->recvBffr));
+    }
+    if (rqstSz == 0)                                                        // no space, data stays at BGx until app fetches
+        return;
+
+    if (scktCtrl->useTls)
+    {
+        atcmd_configDataMode(scktCtrl->dataCntxt, "+QSSLRECV: ", S__scktRxHndlr, NULL, 0, scktCtrl->appRecvDataCB, true);
+        if (!atcmd_tryInvoke("AT+QSSLRECV=%d,%d", scktCtrl->dataCntxt, rqstSz))
+            return;
+    }
+    else
+    {
+        atcmd_configDataMode(scktCtrl->dataCntxt, "+QIRD: ", S__scktRxHndlr, NULL, 0, scktCtrl->appRecvDataCB, true);
+        if (!atcmd_tryInvoke("AT+QIRD=%d,%d", scktCtrl->dataCntxt, rqstSz))
+            return;
+    }
+
+    if (atcmd_awaitResult() == resultCode__success)
+    {
+        scktCtrl->dataPending = atcmd_getValue() > 0;                       // continue until BGx reports buffer drained (read size=0)
+    }
+}
+
+
+/**
+ *   @brief Issue the BGx open command for a socket (QIOPEN/QSSLOPEN), completion is handled by caller.
  */
-resultCode_t sckt_open(scktCtrl_t *scktCtrl, bool cleanSession)
+static bool S__scktInvokeOpen(scktCtrl_t *scktCtrl)
 {
     uint8_t pdpCntxt = (scktCtrl->pdpCntxt == 0) ? g_lqLTEM.providerInfo->defaultContext : scktCtrl->pdpCntxt;
-    resultCode_t rslt;
+    const char *hostAddr = S__scktHostAddr(scktCtrl);
 
-    if (scktCtrl->streamType == 'U')                    // protocol == UDP
+    if (scktCtrl->isService)
     {
-        atcmd_tryInvoke("AT+QIOPEN=%d,%d,\"UDP\",\"%s\",%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->hostUrl, scktCtrl->hostPort, scktCtrl->lclPort);
-        rslt = atcmd_awaitResultWithOptions(sckt__defaultOpenTimeoutMS, S__udptcpOpenCompleteParser);
+        return atcmd_tryInvoke("AT+QIOPEN=%d,%d,\"UDP SERVICE\",\"%s\",0,%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->hostUrl, scktCtrl->lclPort, scktCtrl->accessMode);
     }
-
-    else if (scktCtrl->streamType == 'T')               // protocol == TCP
+    else if (scktCtrl->isListener)
     {
-        atcmd_tryInvoke("AT+QIOPEN=%d,%d,\"TCP\",\"%s\",%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->hostUrl, scktCtrl->hostPort, scktCtrl->lclPort);
-        rslt = atcmd_awaitResultWithOptions(sckt__defaultOpenTimeoutMS, S__udptcpOpenCompleteParser);
+        return atcmd_tryInvoke("AT+QIOPEN=%d,%d,\"TCP LISTENER\",\"%s\",0,%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->hostUrl, scktCtrl->lclPort, scktCtrl->accessMode);
     }
-
-    else if (scktCtrl->streamType == 'S')               // protocol == SSL/TLS
+    else if (scktCtrl->streamType == streamType_UDP)
     {
-        atcmd_tryInvoke("AT+QSSLOPEN=%d,%d,\"SSL\",\"%s\",%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->hostUrl, scktCtrl->hostPort, scktCtrl->lclPort);
-        rslt = atcmd_awaitResultWithOptions(sckt__defaultOpenTimeoutMS, S__sslOpenCompleteParser);
+        return atcmd_tryInvoke("AT+QIOPEN=%d,%d,\"UDP\",\"%s\",%d,%d,%d", pdpCntxt, scktCtrl->dataCntxt, hostAddr, scktCtrl->hostPort, scktCtrl->lclPort, scktCtrl->accessMode);
     }
-
-    if (rslt == resultCode__success)
+    else if (scktCtrl->streamType == streamType_TCP)
     {
-        ltem_addStream(scktCtrl);
+        return atcmd_tryInvoke("AT+QIOPEN=%d,%d,\"TCP\",\"%s\",%d,%d,%d", pdpCntxt, scktCtrl->dataCntxt, hostAddr, scktCtrl->hostPort, scktCtrl->lclPort, scktCtrl->accessMode);
     }
-    return rslt;
+    else if (scktCtrl->streamType == streamType_SSLTLS)
+    {
+        return atcmd_tryInvoke("AT+QSSLOPEN=%d,%d,%d,\"%s\",%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->dataCntxt, hostAddr, scktCtrl->hostPort, scktCtrl->accessMode);
+    }
+    return false;
 }
 
 
+/**
+ *   @brief Get the host address for open; IP address from DNS cache (if enabled), TLS requires host name for certificate validation.
+ */
+static const char* S__scktHostAddr(scktCtrl_t *scktCtrl)
+{
+    if (g_lqLTEM.dnsResolver != NULL && !scktCtrl->useTls)
+        return (*g_lqLTEM.dnsResolver)(scktCtrl->hostUrl);
+    return scktCtrl->hostUrl;
+}
+
 
 /**
- *	@brief Close an established (open) connection socket
+ *   @brief Set socket state following BGx open result.
  */
-void sckt_close(scktCtrl_t *scktCtrl)
+static void S__scktOpenComplete(scktCtrl_t *scktCtrl, resultCode_t openResult)
 {
-    if (scktCtrl->state == scktState_closed)                                    // not open
-        return;
+    scktCtrl->openResult = openResult;
+    scktCtrl->openDuration = pMillis() - scktCtrl->openStart;
+    scktCtrl->state = (openResult == resultCode__success) ? scktState_open : scktState_closed;
+    scktCtrl->dataPending = false;
+    if (scktCtrl->recvBffr != NULL)
+    {
+        cbffr_reset(scktCtrl->recvBffr);
+    }
+}
 
+
+/**
+ *   @brief Issue a single socket read for sckt_flush(), data is discarded by the RX handler.
+ *   @return Chars read (0 = BGx buffer empty), -1 if read command failed
+ */
+static int32_t S__scktFlushRead(scktCtrl_t *scktCtrl, uint16_t readSz)
+{
+    bool invoked;
     if (scktCtrl->useTls)
-        atcmd_tryInvokeDefaults("AT+QSSLCLOSE=%d", scktCtrl->dataCntxt);        // BGx syntax different for SSL
+    {
+        atcmd_configDataMode(scktCtrl->dataCntxt, "+QSSLRECV: ", S__scktRxHndlr, NULL, 0, NULL, true);
+        invoked = atcmd_tryInvoke("AT+QSSLRECV=%d,%d", scktCtrl->dataCntxt, readSz);
+    }
     else
-        atcmd_tryInvokeDefaults("AT+QICLOSE=%d", scktCtrl->dataCntxt);          // BGx syntax different for TCP/UDP
-    
-    if (atcmd_awaitResult() == resultCode__success)
     {
-        scktCtrl->state = scktState_closed;
-        ltem_deleteStream(scktCtrl);
+        atcmd_configDataMode(scktCtrl->dataCntxt, "+QIRD: ", S__scktRxHndlr, NULL, 0, NULL, true);
+        invoked = scktCtrl->isService ? atcmd_tryInvoke("AT+QIRD=%d", scktCtrl->dataCntxt) :           // UDP service reads a datagram
+                                        atcmd_tryInvoke("AT+QIRD=%d,%d", scktCtrl->dataCntxt, readSz);
     }
+    if (!invoked || atcmd_awaitResult() != resultCode__success)
+        return -1;
+    return atcmd_getValue();
 }
 
 
 /**
- *	@brief Close an established (open) connection socket by context number.
- *  @details This is provided for LTEm use in the case of a connection close/loss.
+ *   @brief Parse remote address (UDP service datagram source, TCP listener incoming peer): ,"<remoteIP>",<remote_port>
  */
-void SCKT_closeCntxt(uint8_t cntxtNm)
+static void S__scktParseRemoteAddr(scktCtrl_t *scktCtrl, const char *addrPtr)
 {
-    streamCtrl_t* streamCtrl = ltem_getStreamFromCntxt(cntxtNm, streamType__SCKT);
-    ASSERT(streamCtrl);
+    memset(scktCtrl->remoteIp, 0, sizeof(scktCtrl->remoteIp));
+    scktCtrl->remotePort = 0;
 
-    sckt_close(streamCtrl);
+    const char *ipStart = strchr(addrPtr, '"');
+    if (ipStart == NULL)
+        return;
+    ipStart++;
+    const char *ipEnd = strchr(ipStart, '"');
+    if (ipEnd == NULL)
+        return;
+
+    memcpy(scktCtrl->remoteIp, ipStart, MIN(ipEnd - ipStart, sckt__ipAddrSz - 1));
+    scktCtrl->remotePort = strtol(ipEnd + 2, NULL, 10);                      // skip closing quote and comma
 }
 
 
 /**
- *	@brief Reset open socket connection. This function drains the connection's data pipeline. 
- *
- *  NOT IMPLEMENTED
+ *   @brief Service async open result URC: +QIOPEN: <connectID>,<err> -or- +QSSLOPEN: <clientID>,<err>
+ *   @details While a command is active the URC is only taken at the head of rxBffr, otherwise it is popped with the command 
+ *            response and serviced from there (S__scktOpenResponse).
+ *   @return True if URC was for a socket opening async (serviced)
  */
-bool sckt_flush(scktCtrl_t *scktCtrl)
+static bool S__scktOpenUrc(cBuffer_t *rxBffr)
 {
-    if (scktCtrl->state == scktState_open)
+    for (uint8_t cntxt = 0; cntxt < dataCntxt__cnt; cntxt++)
     {
-    // if (s_requestIrdData(scktCtrl->dataCntxt, scktCtrl->recvBufCtrl._bufferSz, true))      // initiate an IRD flow
-    // {
-    //     scktCtrl->flushing = true;
-         return true;
-    // }
+        scktCtrl_t *scktCtrl = (scktCtrl_t*)ltem_getStreamFromCntxt(cntxt, streamType__SCKT);
+        if (scktCtrl == NULL || scktCtrl->state != scktState_opening)           // sync open result is parsed by sckt_open()
+            continue;
+
+        char urcPrefix[16] = {0};
+        snprintf(urcPrefix, sizeof(urcPrefix), "%s%d,", scktCtrl->useTls ? "+QSSLOPEN: " : "+QIOPEN: ", cntxt);
+
+        int16_t urcIndx = cbffr_find(rxBffr, urcPrefix, 0, 0, false);
+        if (CBFFR_NOTFOUND(urcIndx))
+            continue;
+        if (ATCMD_isLockActive() && urcIndx > 2)                                // command response precedes (2 = leading line-end)
+            continue;
+
+        int16_t eolIndx = cbffr_find(rxBffr, "\r\n", urcIndx, SCKT_URC_HEADERSZ, false);
+        if (CBFFR_FOUND(eolIndx))
+        {
+            char workBffr[SCKT_URC_HEADERSZ + 1] = {0};
+            cbffr_skipTail(rxBffr, urcIndx);
+            cbffr_pop(rxBffr, workBffr, eolIndx - urcIndx + 2);
+            S__scktOpenUrcLine(workBffr);
+        }
+        return true;                                                            // serviced, or incomplete and will be on next pass
+    }
+    return false;
+}
+
+
+/**
+ *   @brief Service async open result URC(s) received with a command response, popped into the response while command was active.
+ */
+static void S__scktOpenResponse()
+{
+    const char *urcPrefixes[] = { "+QIOPEN: ", "+QSSLOPEN: " };
 
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        const char *urcPtr = atcmd_getRawResponse();
+        while ((urcPtr = strstr(urcPtr, urcPrefixes[i])) != NULL && strstr(urcPtr, "\r\n") != NULL)
+        {
+            S__scktOpenUrcLine(urcPtr);
+            urcPtr = strstr(urcPtr, "\r\n");
+        }
     }
+}
+
+
+/**
+ *   @brief Apply an async open result URC line to its socket, if the socket is opening async.
+ *   @param urcLine [in] URC line, starting at +QIOPEN: or +QSSLOPEN:
+ */
+static void S__scktOpenUrcLine(const char *urcLine)
+{
+    bool isSslUrc = urcLine[2] == 'S';
+    char *workPtr;
+    uint8_t cntxt = strtol(strchr(urcLine, ' ') + 1, &workPtr, 10);
+    if (*workPtr != ',' || cntxt >= dataCntxt__cnt)
+        return;
 
-    return false;                                                                       // unable to obtain action lock
+    scktCtrl_t *scktCtrl = (scktCtrl_t*)ltem_getStreamFromCntxt(cntxt, streamType__SCKT);
+    if (scktCtrl == NULL || scktCtrl->state != scktState_opening || scktCtrl->useTls != isSslUrc)
+        return;
+
+    uint16_t errCode = strtol(workPtr + 1, NULL, 10);
+    S__scktOpenComplete(scktCtrl, (errCode == 0) ? resultCode__success : errCode);
+    PRINTF(dbgColor__cyan, "scktOpenUrc() cntxt=%d err=%d %lums\r", cntxt, errCode, scktCtrl->openDuration);
 }
 
 
 /**
- *	@brief Retrieve the state of a socket connection
+ *   @brief Send one segment of a large send (QISEND/QSSLSEND).
  */
-bool sckt_getState(scktCtrl_t *scktCtrl)
+static resultCode_t S__scktSendChunk(scktCtrl_t *scktCtrl, const char *chunk, uint16_t chunkSz)
 {
-    return scktCtrl->state;
+    atcmd_configDataMode(scktCtrl->dataCntxt, "> ", S__scktChunkTxDataHndlr, (char*)chunk, chunkSz, NULL, true);
+
+    bool invoked = scktCtrl->useTls ? atcmd_tryInvoke("AT+QSSLSEND=%d,%d", scktCtrl->dataCntxt, chunkSz) :
+                                      atcmd_tryInvoke("AT+QISEND=%d,%d", scktCtrl->dataCntxt, chunkSz);
+    if (!invoked)
+        return resultCode__conflict;
+
+    resultCode_t rslt = atcmd_awaitResultWithOptions(sckt__sendTimeoutMs, NULL);
+    if (rslt == resultCode__success)
+    {
+        scktCtrl->statsTxCnt++;
+    }
+    S__scktOpenResponse();
+    return rslt;
 }
 
 
 /**
- *	@brief Send data to an established endpoint via protocol used to open socket (TCP/UDP/TCP INCOMING).
+ *   @brief TX data handler for segmented send; starts chunk TX, produces next chunk (if producer) and awaits SEND OK.
  */
-resultCode_t sckt_send(scktCtrl_t *scktCtrl, const char *data, uint16_t dataSz)
+static resultCode_t S__scktChunkTxDataHndlr()
 {
-    resultCode_t rslt;
+    scktCtrl_t *scktCtrl = (scktCtrl_t*)ltem_getStreamFromCntxt(g_lqLTEM.atcmd->dataMode.contextKey, streamType__SCKT);
+    ASSERT(scktCtrl != NULL);
 
-    atcmd_configDataMode(scktCtrl->dataCntxt, "> ", atcmd_stdTxDataHndlr, data, dataSz, NULL, true);
-    atcmd_configDataModeEot(0x1A);
+    IOP_startTx(g_lqLTEM.atcmd->dataMode.txDataLoc, g_lqLTEM.atcmd->dataMode.txDataSz);      // ISR despools current chunk
 
-    if (atcmd_tryInvoke("AT+QISEND=%d,%d", scktCtrl->dataCntxt, dataSz))
+    if (scktCtrl->txProducer != NULL)                                                           // prepare next chunk in other half
     {
-        rslt = atcmd_awaitResultWithOptions(atcmd__defaultTimeout, S__socketSendCompleteParser);
-        if (rslt == resultCode__success)
+        scktCtrl->txNextSz = (*scktCtrl->txProducer)(scktCtrl->dataCntxt, scktCtrl->txNextPtr, scktCtrl->txChunkSz);
+        scktCtrl->txNextReady = true;
+    }
+
+    uint32_t startTime = pMillis();
+    while (pMillis() - startTime < g_lqLTEM.atcmd->timeout)
+    {
+        if (CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "SEND OK\r\n", 0, 0, true)))
         {
-            scktCtrl->statsTxCnt++;
+            cbffr_skipTail(g_lqLTEM.iop->rxBffr, sizeof("SEND OK\r\n") - 1);
+            return resultCode__success;
+        }
+        else if (CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "SEND FAIL\r\n", 0, 0, true)))   // BGx send buffer full
+        {
+            cbffr_skipTail(g_lqLTEM.iop->rxBffr, sizeof("SEND FAIL\r\n") - 1);
+            return resultCode__tooManyRequests;
+        }
+        else if (CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "ERROR\r\n", 0, 0, true)))
+        {
+            cbffr_skipTail(g_lqLTEM.iop->rxBffr, sizeof("ERROR\r\n") - 1);
+            return resultCode__internalError;
         }
+        pDelay(1);
     }
-    atcmd_close();
-    return rslt;                                                            // return sucess -OR- failure from sendRequest\sendRaw action
+    return resultCode__timeout;
 }
 
 
-// static resultCode_t S__scktTxDataHndlr()
-// {
-//     IOP_startTx(g_lqLTEM.atcmd->dataMode.txDataLoc, g_lqLTEM.atcmd->dataMode.txDataSz);
-
-//     uint32_t startTime = pMillis();
+/**
+ *   @brief Complete segmented send statistics.
+ */
+static void S__scktSendResult(scktSendResult_t *sendResult, uint32_t bytesSent, uint16_t chunks, uint32_t startTime)
+{
+    if (sendResult == NULL)
+        return;
 
-//     while (pMillis() - startTime < g_lqLTEM.atcmd->timeout)
-//     {
-//         if (CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "SEND OK", 0, 0, true)))
-//         {
-//             cbffr_skipTail(g_lqLTEM.iop->rxBffr, sizeof("SEND OK") + 1);
-//             return resultCode__success;
-//         }
-//         else if(CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "SEND FAIL", 0, 0, true)))
-//         {
-//             cbffr_skipTail(g_lqLTEM.iop->rxBffr, sizeof("SEND FAIL") + 1);
-//             return resultCode__tooManyRequests;
-//         }
-//         else if(CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "ERROR", 0, 0, true)))
-//         {
-//             cbffr_skipTail(g_lqLTEM.iop->rxBffr, sizeof("SEND FAIL") + 1);
-//             return resultCode__internalError;
-//         }
+    sendResult->bytesSent = bytesSent;
+    sendResult->chunks = chunks;
+    sendResult->durationMs = pMillis() - startTime;
+    sendResult->throughputBps = (sendResult->durationMs > 0) ? (bytesSent * 1000) / sendResult->durationMs : bytesSent;
+    PRINTF(dbgColor__cyan, "sendLarge() bytes=%lu chunks=%d %lums %luB/s\r", bytesSent, chunks, sendResult->durationMs, sendResult->throughputBps);
+}
 
-//         pDelay(1);
-//     }
-//     return resultCode__timeout;
-// }
 
+/**
+ *   @brief Deliver a block of received data to application: push to callback -OR- copy to socket receive buffer (pull-mode).
+ */
+static void S__scktDeliverData(scktCtrl_t *scktCtrl, char *dataPtr, uint16_t dataSz, bool isFinal)
+{
+    if (scktCtrl->flushing)                                                 // sckt_flush() underway, discard
+    {
+        scktCtrl->flushDiscarded += dataSz;
+        return;
+    }
+    if (scktCtrl->isService && scktCtrl->appRecvFromCB != NULL)             // UDP service, datagram with source address
+    {
+        (*scktCtrl->appRecvFromCB)(scktCtrl->dataCntxt, scktCtrl->remoteIp, scktCtrl->remotePort, dataPtr, dataSz, isFinal);
+        return;
+    }
+    if (scktCtrl->recvBffr == NULL)                                         // push-mode
+    {
+        if (scktCtrl->appRecvDataCB == NULL)                                // no receiver (direct-push to idle pooled connection)
+        {
+            scktCtrl->statsRxDropped += dataSz;
+            return;
+        }
+        ((scktAppRecv_func)(*scktCtrl->appRecvDataCB))(scktCtrl->dataCntxt, dataPtr, dataSz, isFinal);    // forward to application
+        return;
+    }
 
-#pragma region private local static functions
-/*-----------------------------------------------------------------------------------------------*/
+    while (dataSz > 0)                                                      // pull-mode
+    {
+        char *pushPtr;
+        uint16_t pushSz = cbffr_pushBlock(scktCtrl->recvBffr, &pushPtr, dataSz);
+        if (pushSz == 0)                                                    // IRD requests sized to vacant space, only direct-push can overflow
+        {
+            scktCtrl->statsRxDropped += dataSz;
+            break;
+        }
+        memcpy(pushPtr, dataPtr, pushSz);
+        cbffr_pushBlockFinalize(scktCtrl->recvBffr, true);
+        dataPtr += pushSz;
+        dataSz -= pushSz;
+    }
+    if (isFinal && scktCtrl->appRecvDataCB != NULL)                         // signal data ready, app fetches at own pace
+    {
+        ((scktAppRecv_func)(*scktCtrl->appRecvDataCB))(scktCtrl->dataCntxt, NULL, cbffr_getOccupied(scktCtrl->recvBffr), true);
+    }
+}
 
-#define SCKT_URC_HEADERSZ 30
 
 /**
- *   @brief Move socket data through pipeline.
+ *   @brief Socket URC handler, parses socket URC events and signals background worker.
  * 
 */
 
     /*
+     * +QIOPEN: <connectID>,<err>       UDP/TCP async open result (sckt_openAsync)
+     * +QSSLOPEN: <clientID>,<err>      SSL/TLS async open result (sckt_openAsync)
+     *
      * +QIURC: "recv",<connectID>       UDP/TCP incoming receive to retrieve with AT+QIRD
+     * +QIURC: "recv",<connectID>,<currentrecvlength>\r\n<data>     direct-push access mode
      * +QIURC: "closed",<connectID>
      * +QIURC: "incoming full"          NOT IMPLEMENTED
      *
      * +QSSLURC: "recv",<clientID>      SSL/TLS incoming receive to retrieve with AT+QSSLRECV
+     * +QSSLURC: "recv",<clientID>,<currentrecvlength>\r\n<data>  direct-push access mode
      * +QSSLURC: "closed",<clientID>
 
      * NOTE:
      * +QIURC: "pdpdeact",<contextID>   // not handled here, falls through to global URC handler
     */
 
-static void S__scktUrcHndlr()
+static resultCode_t S__scktUrcHndlr()
 {
-    cBuffer_t *rxBffr = g_lqLTEM.iop->rxBffr;                           // for convenience
+    cBuffer_t *rxBffr = g_lqLTEM.iop->rxBffr;                               // for convenience
 
-    // not a socket URC or insufficient chars to parse URC header
-    if (cbffr_find(rxBffr, "\"pdpdeact\"", 0, 0, false) >= 0)           // +QIURC: "pdpdeact" handled at higher level, +QIURC overlaps with UDP/TCP
+    if (S__scktOpenUrc(rxBffr))                                             // async open result
     {
-        return;
+        return resultCode__success;
     }
 
-    bool isUdpTcp = CBFFR_FOUND(cbffr_find(rxBffr, "+QIURC", 0, 0, false));
-    bool isSslTls = CBFFR_FOUND(cbffr_find(rxBffr, "+QSSLURC", 0, 0, false));
-    if (!isUdpTcp && !isSslTls)
+    const char *urcPrefixes[] = { "+QIURC: \"recv\"", "+QIURC: \"closed\"", "+QIURC: \"incoming", "+QSSLURC: \"recv\"", "+QSSLURC: \"closed\"" };
+    int16_t urcIndx = CBFFR_NOFIND;
+    bool isUdpTcp = false;
+    for (uint8_t i = 0; i < sizeof(urcPrefixes) / sizeof(urcPrefixes[0]); i++)          // first socket URC in rxBffr
     {
-        return;
+        int16_t prefixIndx = cbffr_find(rxBffr, urcPrefixes[i], 0, 0, false);
+        if (CBFFR_FOUND(prefixIndx) && (CBFFR_NOTFOUND(urcIndx) || prefixIndx < urcIndx))
+        {
+            urcIndx = prefixIndx;
+            isUdpTcp = urcPrefixes[i][2] == 'I';
+        }
     }
-
-    /* UDP/TCP/SSL/TLS URC
-     * ----------------------------------------------------------------------------------------- */
-
-    char workBffr[80] = {0};
-    char *workPtr = workBffr;
-
-    int16_t nextIndx = cbffr_find(rxBffr, "+QIURC", 0, 0, true);            // advance bffr-tail ptr to starting point
-    if (isUdpTcp) 
+    if (CBFFR_NOTFOUND(urcIndx))                                            // not a socket URC (dnsgip, etc. serviced elsewhere)
     {
-        cbffr_skip(rxBffr, 9);                                              // UDP/TCP: + QIURC: "
+        return resultCode__cancelled;
     }
-    else 
+    if (ATCMD_isLockActive() && urcIndx > 2)                                // command response precedes (2 = leading line-end)
     {
-        cbffr_skip(rxBffr, 11);                                             // SSL/TLS: +QSSLURC: "
+        return resultCode__cancelled;
     }
-    uint16_t eolIndx = cbffr_find(rxBffr, "\r\n", 0, 30, false);
-    if (CBFFR_FOUND(eolIndx))                                               // got full line, work on URC
+    if (urcIndx > 0 && CBFFR_FOUND(cbffr_find(rxBffr, "+QIURC: \"pdpdeact\"", 0, urcIndx, false)))  // handled at higher level, don't skip past it
     {
-        cbffr_skipTail(rxBffr, 9);                                          // ignore prefix
-        cbffr_pop(rxBffr, workBffr, eolIndx - 9);
+        return resultCode__cancelled;
     }
-    else
+
+    /* UDP/TCP/SSL/TLS URC
+     * ----------------------------------------------------------------------------------------- */
+
+    char workBffr[SCKT_URC_HEADERSZ + 1] = {0};
+    char *workPtr = workBffr;
+    uint8_t prefixSz = isUdpTcp ? sizeof("+QIURC: \"") - 1 : sizeof("+QSSLURC: \"") - 1;
+
+    int16_t eolIndx = cbffr_find(rxBffr, "\r\n", urcIndx, SCKT_URC_HEADERSZ, false);
+    if (CBFFR_NOTFOUND(eolIndx))
     {
-        return;                                                             // don't have full URC line yet, come back later
+        return resultCode__success;                                         // don't have full URC line yet, come back later
     }
+    cbffr_skipTail(rxBffr, urcIndx + prefixSz);                             // advance to URC, ignore prefix
+    cbffr_pop(rxBffr, workBffr, eolIndx - urcIndx - prefixSz + 2);          // pop URC with line-end
     
     /* URC ready to process
      ----------------------------------------------------------------------- */
     uint8_t dataCntxt;
 
-    uint16_t irdAvailSz = 0;
     // "recv" = socket new data receive
     if (workBffr[0] == 'r')
     {
-        dataCntxt = strtol(workPtr + sizeof("recv\""), NULL, 10);           // valid for both UDP/TCP and SSL
+        dataCntxt = strtol(workPtr + sizeof("recv\""), &workPtr, 10);       // valid for both UDP/TCP and SSL
         ASSERT(dataCntxt < dataCntxt__cnt);
 
-        streamCtrl_t* streamCtrl = ltem_getStreamFromCntxt(dataCntxt, streamType__ANY);
-        ASSERT(streamCtrl->streamType == streamType_UDP ||
-               streamCtrl->streamType == streamType_TCP ||
-               streamCtrl->streamType == streamType_SSLTLS);
-        scktCtrl_t* scktCtrl = (scktCtrl_t*)streamCtrl;
-
-        uint16_t irdRemain = 0;
-        do
+        scktCtrl_t* scktCtrl = (scktCtrl_t*)ltem_getStreamFromCntxt(dataCntxt, streamType__SCKT);
+        if (*workPtr == ',')                                                // direct-push: data length follows, data follows URC line
         {
-            uint16_t irdRqstSz = cbffr_getVacant(g_lqLTEM.iop->rxBffr) / 2;     // request up to half of available buffer space
-            if (isUdpTcp)
+            uint16_t pushSz = strtol(workPtr + 1, &workPtr, 10);
+            if (scktCtrl == NULL)                                           // no stream for context (closed/re-init race), discard pushed data
             {
-                atcmd_configDataMode(scktCtrl->dataCntxt, "+QIRD: ", S__scktRxHndlr, NULL, 0, scktCtrl->appRecvDataCB, true);
-                atcmd_tryInvoke("AT+QIRD=%d,%d", (uint8_t)dataCntxt, irdRqstSz);
+                PRINTF(dbgColor__warn, "scktUrc() push for unregistered cntxt=%d, discard %d\r", dataCntxt, pushSz);
+                return S__scktStreamData(NULL, pushSz);
             }
-            else
+            if (scktCtrl->isService)                                        // UDP service: ,"<remoteIP>",<remote_port> follows length
             {
-                atcmd_configDataMode(scktCtrl->dataCntxt, "+QSSLRECV: ", S__scktRxHndlr, NULL, 0, scktCtrl->appRecvDataCB, true);
-                atcmd_tryInvoke("AT+QSSLRECV=%d,%d", (uint8_t)dataCntxt, irdRqstSz);
+                S__scktParseRemoteAddr(scktCtrl, workPtr);
             }
-            atcmd_awaitResult();
-            irdRemain = atcmd_getValue();
-
-        } while (irdRemain > 0);
+            return S__scktStreamData(scktCtrl, pushSz);
+        }
+        else if (scktCtrl != NULL)
+        {
+            scktCtrl->dataPending = true;                                   // background worker will IRD/SSLRECV when command lock is free
+        }
     }
 
     // "closed" = socket closed
-    if (workBffr[0] == 'c')                                                
+    else if (workBffr[0] == 'c')                                                
     {
-        dataCntxt = strtol(workPtr + sizeof("closed\"") , NULL, 10);
+        dataCntxt = strtol(workPtr + sizeof("closed\""), NULL, 10);
         ASSERT(dataCntxt < dataCntxt__cnt);
 
-        uint8_t indx = LTEM__getStreamIndx(dataCntxt);
-        ((scktCtrl_t*)g_lqLTEM.streams[indx])->state = scktState_closed;
+        scktCtrl_t* scktCtrl = (scktCtrl_t*)ltem_getStreamFromCntxt(dataCntxt, streamType__SCKT);
+        if (scktCtrl != NULL)
+        {
+            scktCtrl->state = scktState_closed;                             // remaining data can still be read, sckt_close() releases BGx context
+        }
     }
 
-    return;
+    // "incoming" = TCP listener new connection -or- "incoming full" (BGx has no free context)
+    else if (workBffr[0] == 'i')
+    {
+        S__scktIncomingUrc(workBffr);
+    }
+    return resultCode__success;
 }    
 
 
+/**
+ * @brief Service TCP listener incoming connection: incoming",<connectID>,<serverID>,"<remoteIP>",<remote_port>
+ */
+static void S__scktIncomingUrc(char *urcPtr)
+{
+    uint32_t acceptStart = pMillis();
+
+    if (memcmp(urcPtr, "incoming full", 13) == 0)                           // BGx rejected connection, count at listener(s)
+    {
+        for (uint8_t cntxt = 0; cntxt < dataCntxt__cnt; cntxt++)
+        {
+            scktCtrl_t *scktCtrl = (scktCtrl_t*)ltem_getStreamFromCntxt(cntxt, streamType__SCKT);
+            if (scktCtrl != NULL && scktCtrl->acceptCB != NULL)
+                scktCtrl->statsRejected++;
+        }
+        return;
+    }
+
+    char *workPtr;
+    uint8_t connCntxt = strtol(urcPtr + sizeof("incoming\""), &workPtr, 10);
+    uint8_t listenerCntxt = strtol(workPtr + 1, &workPtr, 10);
+    ASSERT(connCntxt < dataCntxt__cnt && listenerCntxt < dataCntxt__cnt);
+
+    scktCtrl_t *listener = (scktCtrl_t*)ltem_getStreamFromCntxt(listenerCntxt, streamType__SCKT);
+    if (listener == NULL || listener->acceptCB == NULL)
+        return;
+
+    S__scktParseRemoteAddr(listener, workPtr);
+    scktCtrl_t *connCtrl = (*listener->acceptCB)(listenerCntxt, connCntxt, listener->remoteIp, listener->remotePort);
+    if (connCtrl == NULL)
+    {
+        listener->rejectPending |= (1 << connCntxt);                        // AT+QICLOSE by background worker
+        listener->statsRejected++;
+        return;
+    }
+    ASSERT(connCtrl->dataCntxt == connCntxt && connCtrl->streamType == streamType_TCP);
+
+    strncpy(connCtrl->hostUrl, listener->remoteIp, sckt__urlHostSz);
+    connCtrl->hostPort = listener->remotePort;
+    connCtrl->lclPort = listener->lclPort;
+    connCtrl->pdpCntxt = listener->pdpCntxt;
+    connCtrl->accessMode = listener->accessMode;                            // BGx connection inherits listener access mode
+    connCtrl->listener = listener;
+    connCtrl->openStart = acceptStart;
+    S__scktOpenComplete(connCtrl, resultCode__success);
+    ltem_addStream((streamCtrl_t*)connCtrl);
+
+    listener->statsAccepted++;
+    listener->statsConnectionsPeak = MAX(listener->statsConnectionsPeak, sckt_getConnectionCnt(listener));
+    listener->statsAcceptLatencyMs = pMillis() - acceptStart;
+    listener->statsAcceptLatencyMaxMs = MAX(listener->statsAcceptLatencyMaxMs, listener->statsAcceptLatencyMs);
+}
+
+
+/**
+ * @brief Stream a known length of socket data from the RX buffer to the application (IRD/SSLRECV response or direct-push URC).
+ * @param scktCtrl [in] Socket receiving data, NULL to discard data.
+ */
+static resultCode_t S__scktStreamData(scktCtrl_t *scktCtrl, uint16_t dataSz)
+{
+    while (dataSz > 0)
+    {
+        uint32_t readTimeout = pMillis();
+        while (cbffr_getOccupied(g_lqLTEM.iop->rxBffr) == 0)                                                    // wait for buffer to recv data
+        {
+            pDelay(1);                                                                                          // yield
+            if (pElapsed(readTimeout, sckt__readTimeoutMs))                                                     // modem/link stall, remaining data is lost
+            {
+                if (scktCtrl != NULL)
+                    scktCtrl->statsRxDropped += dataSz;
+                return resultCode__timeout;
+            }
+        }
+        
+        char* streamPtr;
+        uint16_t blockSz = cbffr_popBlock(g_lqLTEM.iop->rxBffr, &streamPtr, dataSz);                            // get data ptr from rxBffr
+        PRINTF(dbgColor__cyan, "scktStreamData() ptr=%p, blkSz=%d, availSz=%d\r", streamPtr, blockSz, dataSz);
+
+        dataSz -= blockSz;
+        if (scktCtrl != NULL)
+            S__scktDeliverData(scktCtrl, streamPtr, blockSz, dataSz == 0);                                      // forward to application
+        cbffr_popBlockFinalize(g_lqLTEM.iop->rxBffr, true);                                                     // commit POP
+    }
+    if (scktCtrl != NULL)
+        scktCtrl->statsRxCnt++;
+    return resultCode__success;
+}
+
+
 /**
  * @brief Socket protocol (UDP/TCP/SSL) stream RX data handler, marshalls incoming data from RX buffer to app (application).
  */
 static resultCode_t S__scktRxHndlr()
 {
     /* +QIRD: <read_actual_length>/r/n<data>
+     * +QIRD: <read_actual_length>,"<remoteIP>",<remote_port>/r/n<data>        UDP service
      * +QSSLRECV: <havereadlen>/r/n<data>
      */
 
-    char wrkBffr[32] = {0};
+    char wrkBffr[SCKT_URC_HEADERSZ] = {0};
     char *wrkPtr = wrkBffr;
-    streamCtrl_t* streamCtrl = ltem_getStreamFromCntxt(g_lqLTEM.atcmd->dataMode.contextKey, streamType__ANY);
-
-    ASSERT(streamCtrl->streamType == streamType_UDP ||                                                          // assert that the stream config is consistent
-           streamCtrl->streamType == streamType_TCP || 
-           streamCtrl->streamType == streamType_SSLTLS);
-    scktCtrl_t *scktCtrl = (scktCtrl_t*)streamCtrl;
+    scktCtrl_t *scktCtrl = (scktCtrl_t*)ltem_getStreamFromCntxt(g_lqLTEM.atcmd->dataMode.contextKey, streamType__SCKT);
+    ASSERT(scktCtrl != NULL);                                                                                   // assert that the stream config is consistent
     
-    pDelay(1);                                                                                                  // ugly, but creating loop to wait 500uS seems silly
-    uint8_t popCnt = cbffr_find(g_lqLTEM.iop->rxBffr, "\r", 0, 0, false);
-    if (CBFFR_NOTFOUND(popCnt))
+    uint32_t readTimeout = pMillis();
+    int16_t popCnt;
+    do                                                                                                          // wait for length line-end
     {
-        return resultCode__internalError;
-    }
+        popCnt = cbffr_find(g_lqLTEM.iop->rxBffr, "\r\n", 0, sizeof(wrkBffr) - 3, false);                  // leave room for \0
+        if (pElapsed(readTimeout, sckt__readTimeoutMs))
+            return resultCode__internalError;
+    } while (CBFFR_NOTFOUND(popCnt));
     
     cbffr_pop(g_lqLTEM.iop->rxBffr, wrkBffr, popCnt + 2);                                                       // pop preamble phrase to parse data length
-    wrkPtr = memchr(wrkBffr, ':', popCnt) + 2;
-    uint16_t irdSz = strtol(wrkPtr, NULL, 10);
+    wrkPtr = memchr(wrkBffr, ':', popCnt);
+    if (wrkPtr == NULL)                                                                                         // malformed or truncated header
+        return resultCode__internalError;
+    wrkPtr += 2;
+    uint16_t irdSz = strtol(wrkPtr, &wrkPtr, 10);
     g_lqLTEM.atcmd->retValue = irdSz;
+    if (scktCtrl->isService && irdSz > 0)
+    {
+        S__scktParseRemoteAddr(scktCtrl, wrkPtr);
+    }
 
     PRINTF(dbgColor__cyan, "scktRxHndlr() cntxt=%d irdSz=%d\r", scktCtrl->dataCntxt, irdSz);
 
-    while (irdSz > 0)
-    {
-        uint32_t readTimeout = pMillis();
-        uint16_t bffrCnt;
-        do                                                                                                      // wait for buffer to recv IRD data
-        {
-            bffrCnt = cbffr_getOccupied(g_lqLTEM.iop->rxBffr);
-            ASSERT_NOTSTALLED(readTimeout, sckt__readTimeoutMs);
-        } while (bffrCnt < sckt__irdRequestPageSz);
-        
-        char* streamPtr;
-        uint16_t blockSz = cbffr_popBlock(g_lqLTEM.iop->rxBffr, &streamPtr, irdSz);                             // get data ptr from rxBffr
-        PRINTF(dbgColor__cyan, "scktRxHndlr() ptr=%p, blkSz=%d, availSz=%d\r", streamPtr, blockSz, irdSz);
-
-        irdSz -= blockSz;
-        ((scktAppRecv_func)(*scktCtrl->appRecvDataCB))(scktCtrl->dataCntxt, streamPtr, blockSz, irdSz == 0);    // forward to application
-        cbffr_popBlockFinalize(g_lqLTEM.iop->rxBffr, true);                                                     // commit POP
+    resultCode_t rslt = S__scktStreamData(scktCtrl, irdSz);
+    if (rslt != resultCode__success)
+        return rslt;
 
-        if (irdSz == 0)                                                                                         // done with data
-        {
-            while (cbffr_getOccupied(g_lqLTEM.iop->rxBffr) < sckt__readTrailerSz)
-            {
-                pDelay(1);                                                                                      // yield
-                ASSERT_NOTSTALLED(readTimeout, sckt__readTimeoutMs);
-            }
-            cbffr_skipTail(g_lqLTEM.iop->rxBffr, sckt__readTrailerSz);
-        }
+    readTimeout = pMillis();
+    while (cbffr_getOccupied(g_lqLTEM.iop->rxBffr) < sckt__readTrailerSz)                                       // done with data, trailer follows (also on zero length read)
+    {
+        pDelay(1);                                                                                              // yield
+        DETECT_STALL(readTimeout, sckt__readTimeoutMs);
     }
+    cbffr_skipTail(g_lqLTEM.iop->rxBffr, sckt__readTrailerSz);
     return resultCode__success;
 }
 
@@ -456,6 +1517,16 @@ static cmdParseRslt_t S__irdResponseHeaderParser()
 }
 
 
+/**
+ *	\brief [private] UDP/TCP IRD query (length=0) response parser: +QIRD: <total_receive_length>,<have_read_length>,<unread_length>
+ *  \return LTEmC parse result, value is unread length
+ */
+static cmdParseRslt_t S__irdQueryParser() 
+{
+    return atcmd_stdResponseParser("+QIRD: ", true, ",", 3, 3, "OK\r\n", 0);
+}
+
+
 /**
  *	\brief [private] UDP/TCP (IRD Request) response parser.
  *  \return LTEmC parse result
@@ -494,16 +1565,31 @@ static cmdParseRslt_t S__socketSendCompleteParser(const char *response, char **e
 
 
 /**
- *	@brief [static] Socket status parser
- *  @details Wraps generic atcm
- *  @param response [in] Character data recv'd from BGx to parse for task complete
- *  @param endptr [out] Char pointer to the char following parsed text
- *  @return HTTP style result code, 0 = not complete
+ *	@brief [private] Transparent mode open/resume parser, BGx responds with CONNECT on entry to transparent mode.
+ */
+static cmdParseRslt_t S__transparentConnectParser() 
+{
+    return atcmd_stdResponseParser("", false, "", 0, 0, "CONNECT\r\n", 0);
+}
+
+
+/**
+ *	\brief [private] Socket status parser: +QISTATE: <connectID>,"<service_type>","<IP_address>",<remote_port>,<local_port>,<socket_state>,...
+ *  \return LTEmC parse result, value is socket_state (2 = connected)
+ */
+static cmdParseRslt_t S__socketStatusParser() 
+{
+    return atcmd_stdResponseParser("+QISTATE: ", true, ",", 6, 6, "OK\r\n", 0);
+}
+
+
+/**
+ *	\brief [private] SSL socket status parser: +QSSLSTATE: <clientID>,"SSLClient","<IP_address>",<remote_port>,<local_port>,<socket_state>,...
+ *  \return LTEmC parse result, value is socket_state (2 = connected)
  */
-static cmdParseRslt_t S__socketStatusParser(const char *response, char **endptr) 
+static cmdParseRslt_t S__sslStatusParser() 
 {
-    // BGx +QMTCONN Read returns Status = 3 for connected, service parser returns 203
-    return atcmd_serviceResponseParser(response, "+QISTATE: ", 5, endptr) == 202 ? resultCode__success : resultCode__unavailable;
+    return atcmd_stdResponseParser("+QSSLSTATE: ", true, ",", 6, 6, "OK\r\n", 0);
 }
 
 #pragma endregion
@@ -35,6 +35,8 @@
 
 /** 
  *  @brief Callback function for data received event. Marshalls received data to application.
+ *  @details If the socket has a receive buffer (sckt_setRecvBuffer), data is not passed in the callback; dataPtr is NULL and 
+ *           dataSz is the number of chars available to fetch with sckt_fetchRecv()/sckt_peek().
 
  *  @param dataCntxt [in] Data context (socket) with new received data available.
  *  @param [in] dataPtr Pointer to the received data available to the application.
@@ -45,6 +47,56 @@
 typedef void (*scktAppRecv_func)(dataCntxt_t dataCntxt, char* dataPtr, uint16_t dataSz, bool isFinal);
 
 
+/** 
+ *  @brief Callback function for UDP service datagram received event. Marshalls received datagram and its source to application.
+
+ *  @param dataCntxt [in] Data context (socket) with new received data available.
+ *  @param [in] remoteIp Source IP address of the datagram.
+ *  @param [in] remotePort Source port of the datagram.
+ *  @param [in] dataPtr Pointer to the received data available to the application.
+ *  @param [in] dataSz Size of the data block present at the dataPtr location.
+ *  @param [in] isFinal True if this block of data is the last block of the datagram.
+*/
+typedef void (*scktAppRecvFrom_func)(dataCntxt_t dataCntxt, const char* remoteIp, uint16_t remotePort, char* dataPtr, uint16_t dataSz, bool isFinal);
+
+
+/** 
+ *  @brief Callback function for TCP listener incoming connection event. Application accepts the connection by returning a 
+ *         socket control initialized (sckt_initControl) for connCntxt, or rejects it by returning NULL.
+ *  @details Invoked from ltem_eventMgr() URC processing, the application must not issue AT commands from this callback.
+
+ *  @param listenerCntxt [in] Data context of the listener receiving the connection.
+ *  @param connCntxt [in] Data context assigned by BGx to the new connection.
+ *  @param [in] remoteIp IP address of the connecting peer.
+ *  @param [in] remotePort Port of the connecting peer.
+ *  @return Socket control to host the connection, NULL to reject (connection is closed in background).
+*/
+typedef struct scktCtrl_tag* (*scktAccept_func)(dataCntxt_t listenerCntxt, dataCntxt_t connCntxt, const char* remoteIp, uint16_t remotePort);
+
+
+/** 
+ *  @brief Callback function to produce send data for sckt_sendFromProducer(). Invoked while the prior chunk is being sent.
+
+ *  @param dataCntxt [in] Data context (socket) sending the data.
+ *  @param [out] chunkBffr Buffer for producer to fill with the next chunk of send data.
+ *  @param [in] chunkBffrSz Maximum number of chars to place in chunkBffr.
+ *  @return Number of chars placed in chunkBffr, 0 signals end of send data.
+*/
+typedef uint16_t (*scktSendProducer_func)(dataCntxt_t dataCntxt, char* chunkBffr, uint16_t chunkBffrSz);
+
+
+/** 
+ *  @brief Results of a segmented (large) send.
+*/
+typedef struct scktSendResult_tag
+{
+    uint32_t bytesSent;                         /// chars accepted by BGx (SEND OK)
+    uint16_t chunks;                            /// number of QISEND/QSSLSEND segments
+    uint32_t durationMs;                        /// elapsed time for complete send
+    uint32_t throughputBps;                     /// effective throughput (bytes/second)
+} scktSendResult_t;
+
+
 
 /** 
  *  @brief Typed numeric constants for the sockets subsystem
@@ -52,13 +104,18 @@ typedef void (*scktAppRecv_func)(dataCntxt_t dataCntxt, char* dataPtr, uint16_t
 enum sckt__constants
 {
     sckt__urlHostSz = 128,
+    sckt__ipAddrSz = 40,                    /// IPv4/IPv6 address string (UDP service remote address)
     sckt__resultCode_alreadyOpen = 563,
     sckt__defaultOpenTimeoutMS = 60000,
     sckt__irdRequestMaxSz = 1500,
     sckt__irdRequestPageSz = sckt__irdRequestMaxSz / 2,
+    sckt__sendMaxSz = 1460,                 /// max data for a single QISEND (TCP MSS)
+    sckt__sendTimeoutMs = 5000,             /// max wait for SEND OK following data
 
     sckt__readTrailerSz = 6,                /// /r/nOK/r/n
-    sckt__readTimeoutMs = 1000
+    sckt__readTimeoutMs = 1000,
+    sckt__transparentTxTimeoutMs = 5000,    /// max wait for transparent write to clear UART
+    sckt__transparentExitTimeoutMs = 2000   /// max wait for OK following +++ escape
 };
 
 
@@ -66,10 +123,22 @@ typedef enum scktState_tag
 {
     scktState_closed = 0,
     scktState_flushPending,
-    scktState_open
+    scktState_open,
+    scktState_opening                           /// async open (sckt_openAsync) underway, awaiting +QIOPEN/+QSSLOPEN result
 } scktState_t;
 
 
+/** 
+ *  @brief BGx socket data access mode, determines how received data is delivered by the BGx.
+*/
+typedef enum scktAccessMode_tag
+{
+    scktAccessMode_buffer = 0,                  /// BGx buffers received data, URC signals data ready, data retrieved with IRD/SSLRECV (default)
+    scktAccessMode_directPush = 1,              /// BGx pushes received data inline following URC: +QIURC: "recv",<id>,<len>\r\n<data>
+    scktAccessMode_transparent = 2              /// UART carries raw socket data, no AT framing (sckt_openTransparent)
+} scktAccessMode_t;
+
+
 /** 
  *  @brief Struct representing the state of a TCP/UDP/SSL socket stream.
 */
@@ -88,12 +157,51 @@ typedef struct scktCtrl_tag
     uint16_t hostPort;
     uint16_t lclPort;
     bool useTls;
+    bool isService;                             /// UDP service: context is not bound to a remote host, datagram source reported per receive
+    bool isListener;                            /// TCP listener: context accepts incoming connections, carries no data
+    scktAccessMode_t accessMode;                /// BGx data access mode, set before open
     scktState_t state;
-
-    bool flushing;                              /// True if the socket was opened with cleanSession and the socket was found already open.
+    resultCode_t openResult;                    /// async open: result reported by +QIOPEN/+QSSLOPEN (BGx error code if failed)
+    uint32_t openStart;                         /// async open: tick count open was requested
+    bool openUnreported;                        /// async open: completion not yet reported by sckt_awaitAnyOpen()
+    uint32_t openDuration;                      /// duration (ms) from open request to connection result
+    cBuffer_t recvBffrCtrl;                     /// pull-mode: ring buffer control over application supplied receive buffer
+    cBuffer_t *recvBffr;                        /// pull-mode: ring buffer with received data for application to fetch, NULL = push-mode (callback)
+    bool dataPending;                           /// BGx has reported data for socket not yet retrieved (IRD/SSLRECV)
+    scktAppRecvFrom_func appRecvFromCB;         /// UDP service: callback into host application with datagram and its source address
+    char remoteIp[sckt__ipAddrSz];              /// UDP service: source address of datagram being received (listener: last peer)
+    uint16_t remotePort;                        /// UDP service: source port of datagram being received
+
+    scktAccept_func acceptCB;                   /// TCP listener: application accept callback for incoming connections
+    struct scktCtrl_tag *listener;              /// accepted connection: listener that accepted the connection, NULL = client socket
+    uint8_t rejectPending;                      /// TCP listener: bitmap (by data context) of rejected connections awaiting close
+    uint16_t statsAccepted;                     /// TCP listener: incoming connections accepted
+    uint16_t statsRejected;                     /// TCP listener: incoming connections rejected by application or BGx (incoming full)
+    uint8_t statsConnectionsPeak;               /// TCP listener: max concurrent accepted connections
+    uint32_t statsAcceptLatencyMs;              /// TCP listener: last incoming URC to connection ready (includes application accept)
+    uint32_t statsAcceptLatencyMaxMs;           /// TCP listener: max accept latency
+
+    bool flushing;                              /// True while sckt_flush() is draining the socket, received data is discarded (no app callback)
+    uint32_t flushDiscarded;                    /// chars discarded by last sckt_flush() (driver receive buffer and BGx)
+    uint32_t flushDuration;                     /// duration (ms) of last sckt_flush()
     uint16_t irdPending;                        /// Char count of remaining for current IRD/SSLRECV flow. Starts at reported IRD value and counts down
     uint32_t statsTxCnt;                        /// Number of atomic TX sends
     uint32_t statsRxCnt;                        /// Number of atomic RX segments (URC/IRD)
+    uint32_t statsRxDropped;                    /// Number of chars discarded, direct-push data received with pull-mode receive buffer full or lost to a stall
+
+    char *txCoalesceBffr;                       /// send coalescing: application supplied buffer for pending writes, NULL = disabled
+    uint16_t txCoalesceBffrSz;
+    uint16_t txCoalescePending;                 /// chars in coalescing buffer awaiting send
+    uint16_t txFlushSz;                         /// send when pending reaches this size
+    uint32_t txFlushAgeMs;                      /// send when oldest pending write reaches this age (background worker)
+    uint32_t txCoalesceStart;                   /// tick count of first write in pending buffer
+    uint32_t statsTxCoalesced;                  /// Number of writes combined into another write's send (sends avoided)
+
+    scktSendProducer_func txProducer;           /// segmented send: producer for next chunk, invoked during current chunk SEND OK wait
+    char *txNextPtr;                            /// segmented send: location for next chunk (alternate half of work buffer)
+    uint16_t txNextSz;                          /// segmented send: next chunk size produced, valid if txNextReady
+    uint16_t txChunkSz;                         /// segmented send: max chunk size
+    bool txNextReady;                           /// segmented send: next chunk prepared
 } scktCtrl_t;
 
 
@@ -129,6 +237,51 @@ void sckt_initControl(scktCtrl_t *scktCtrl, dataCntxt_t dataCntxt, streamType_t
 void sckt_setConnection(scktCtrl_t *scktCtrl, uint8_t pdpCntxt, const char *hostUrl, const uint16_t hostPort, uint16_t lclPort);
 
 
+/**
+ *	@brief Set a UDP socket to service mode ("UDP SERVICE"); the socket is bound to a local port only and can exchange 
+ *         datagrams with any number of remote peers.
+ *  @details Datagrams are sent with sckt_sendTo() and are received with their source address in recvFromCallback. Receive 
+ *           is push-mode only, a pull-mode receive buffer (sckt_setRecvBuffer) would lose datagram boundaries and sources.
+ *  @param scktCtrl [in/out] Pointer to socket control structure, initialized as streamType_UDP
+ *  @param pdpCntxt [in] - The PDP context supporting this socket, 0 = default context
+ *  @param lclPort [in] - The local port the service listens on
+ *  @param recvFromCallback [in] - Callback in your application to receive datagrams and their source address
+ */
+void sckt_setService(scktCtrl_t *scktCtrl, uint8_t pdpCntxt, uint16_t lclPort, scktAppRecvFrom_func recvFromCallback);
+
+
+/**
+ *	@brief Set a TCP socket to listener mode ("TCP LISTENER"), accepting incoming connections on a local port.
+ *  @details The BGx assigns each incoming connection a free data context, reported with +QIURC: "incoming". The accept 
+ *           callback supplies the socket control for the connection; the connection is open on return and is used and 
+ *           closed like any client socket. Listener metrics are kept in the listener control statsXXX fields.
+ *  @param scktCtrl [in/out] Pointer to socket control structure, initialized as streamType_TCP
+ *  @param pdpCntxt [in] - The PDP context supporting this socket, 0 = default context
+ *  @param lclPort [in] - The local port to listen on
+ *  @param acceptCallback [in] - Callback in your application to accept/reject incoming connections
+ */
+void sckt_setListener(scktCtrl_t *scktCtrl, uint8_t pdpCntxt, uint16_t lclPort, scktAccept_func acceptCallback);
+
+
+/**
+ *	@brief Get the number of open connections accepted by a TCP listener.
+ *  @param scktCtrl [in] Pointer to listener socket control
+ *  @return Number of accepted connections currently open
+ */
+uint8_t sckt_getConnectionCnt(scktCtrl_t *scktCtrl);
+
+
+/**
+ *	@brief Set the BGx data access mode for a socket connection, applied at sckt_open().
+ *  @details Direct-push eliminates the IRD/SSLRECV command round-trip for each received segment. In direct-push there is no 
+ *           flow control from the host; if the socket has a pull-mode receive buffer, data exceeding the buffer vacant space 
+ *           is discarded (counted in statsRxDropped).
+ *  @param scktCtrl [in/out] Pointer to socket control structure
+ *  @param accessMode [in] - Buffer (default) or direct-push
+ */
+void sckt_setAccessMode(scktCtrl_t *scktCtrl, scktAccessMode_t accessMode);
+
+
 /**
  *	@brief Open a data connection (socket) to d data to an established endpoint via protocol used to open socket (TCP/UDP/TCP INCOMING)
  *  @param scktCtrl [in/out] Pointer to socket control structure
@@ -138,6 +291,90 @@ void sckt_setConnection(scktCtrl_t *scktCtrl, uint8_t pdpCntxt, const char *host
 resultCode_t sckt_open(scktCtrl_t *scktCtrl, bool cleanSession);
 
 
+/**
+ *	@brief Initiate a socket open without waiting for the connection; returns after BGx accepts the request (OK).
+ *  @details The +QIOPEN/+QSSLOPEN result URC completes the open in the background (ltem_eventMgr()), allowing multiple 
+ *           socket handshakes to proceed concurrently in the BGx. State is scktState_opening until the result arrives, then 
+ *           scktState_open or scktState_closed with openResult set. A failed open must still be released with sckt_close().
+ *  @param scktCtrl [in/out] Pointer to socket control structure
+ *  @return Result code similar to http status code, OK = 200 (open request accepted)
+ */
+resultCode_t sckt_openAsync(scktCtrl_t *scktCtrl);
+
+
+/**
+ *	@brief Wait for any of a set of async opening sockets to complete (open or failed).
+ *  @param scktCtrls [in] Array of pointers to socket controls, opened with sckt_openAsync()
+ *  @param scktCnt [in] Number of sockets in array
+ *  @param timeoutMS [in] Maximum time to wait
+ *  @details Only async opens are reported, each once: a socket already open or closed before the wait (sync open, reported 
+ *           by a previous wait) is not. Call again to collect further completions.
+ *  @return Index of first socket in array with an async open completed and not yet reported, -1 if timeout
+ */
+int8_t sckt_awaitAnyOpen(scktCtrl_t *scktCtrls[], uint8_t scktCnt, uint32_t timeoutMS);
+
+
+/**
+ *	@brief Wait for all of a set of async opening sockets to complete (open or failed).
+ *  @param scktCtrls [in] Array of pointers to socket controls, opened with sckt_openAsync()
+ *  @param scktCnt [in] Number of sockets in array
+ *  @param timeoutMS [in] Maximum time to wait
+ *  @return Result code, OK = 200 all sockets open; otherwise timeout or the openResult of the first failed socket
+ */
+resultCode_t sckt_awaitAllOpen(scktCtrl_t *scktCtrls[], uint8_t scktCnt, uint32_t timeoutMS);
+
+
+/**
+ *	@brief Open a socket in transparent (passthrough) access mode; UART carries raw socket data in both directions.
+ *  @details While in transparent mode the AT command interface is held (locked) and ltem_eventMgr() performs no URC or 
+ *           background processing. Use sckt_transparentRead()/sckt_transparentWrite() for data, sckt_exitTransparent() to 
+ *           return to command mode. Only one socket can be in transparent mode. A remote close is signaled in-band by the 
+ *           BGx with "NO CARRIER" and returns the BGx to command mode.
+ *  @param scktCtrl [in/out] Pointer to socket control structure
+ *  @return Result code similar to http status code, OK = 200
+ */
+resultCode_t sckt_openTransparent(scktCtrl_t *scktCtrl);
+
+
+/**
+ *	@brief Read raw received data from a socket in transparent mode (non-blocking).
+ *  @details Application should read frequently, LTEm RX buffer is not flow controlled in transparent mode.
+ *  @param scktCtrl [in] Pointer to socket control structure
+ *  @param recvBffr [out] Buffer to receive data
+ *  @param bffrSz [in] Size of recvBffr
+ *  @return Number of chars copied to recvBffr
+ */
+uint16_t sckt_transparentRead(scktCtrl_t *scktCtrl, char *recvBffr, uint16_t bffrSz);
+
+
+/**
+ *	@brief Write raw data to a socket in transparent mode, returns after data is sent out UART to BGx.
+ *  @param scktCtrl [in] Pointer to socket control structure
+ *  @param data [in] Data to send
+ *  @param dataSz [in] Number of chars to send
+ *  @return Number of chars sent, 0 if the UART could not be cleared (timeout)
+ */
+uint16_t sckt_transparentWrite(scktCtrl_t *scktCtrl, const char *data, uint16_t dataSz);
+
+
+/**
+ *	@brief Exit transparent mode to command mode (guarded +++ escape), the socket connection remains open.
+ *  @details Blocking for approximately 2 seconds for escape guard times. Data received while in command mode is buffered at 
+ *           the BGx and can be retrieved by IRD, or after sckt_resumeTransparent().
+ *  @param scktCtrl [in] Pointer to socket control structure
+ *  @return Result code similar to http status code, OK = 200
+ */
+resultCode_t sckt_exitTransparent(scktCtrl_t *scktCtrl);
+
+
+/**
+ *	@brief Return a socket previously exited with sckt_exitTransparent() to transparent mode.
+ *  @param scktCtrl [in] Pointer to socket control structure
+ *  @return Result code similar to http status code, OK = 200
+ */
+resultCode_t sckt_resumeTransparent(scktCtrl_t *scktCtrl);
+
+
 /**
  *	@brief Close an established (open) connection socket
  *	@param scktCtrl [in] - Pointer to socket control struct governing the sending socket's operation
@@ -154,9 +391,13 @@ void SCKT_closeCntxt(uint8_t cntxtNm);
 
 
 /**
- *	@brief Reset open socket connection. This function drains the connection's data pipeline 
+ *	@brief Drain the connection's receive data pipeline, discarding all data received and not yet read by the application.
+ *  @details Blocking. Driver receive buffer is cleared and BGx buffered data is retrieved in maximal reads and discarded 
+ *           without application callbacks. For UDP/TCP the BGx unread length is queried first (IRD=<id>,0) so no read is 
+ *           issued when the BGx is empty. The connection remains open. Chars discarded and duration are reported in the 
+ *           socket control flushDiscarded and flushDuration fields.
  *	@param scktCtrl [in] - Pointer to socket control struct governing the sending socket's operation
- *  @return True if flush socket data initiated
+ *  @return True if socket data flushed; false if socket not open or unable to obtain command lock
  */
 bool sckt_flush(scktCtrl_t *scktCtrl);
 
@@ -171,6 +412,15 @@ bool sckt_flush(scktCtrl_t *scktCtrl);
 bool sckt_getState(scktCtrl_t *scktCtrl);
 
 
+/**
+ *	@brief Query the BGx for the connection state of a socket (QISTATE/QSSLSTATE), socket state is set closed if not connected.
+
+ *	@param scktCtrl [in] - Pointer to socket control struct governing the sending socket's operation
+ *  @return Result code similar to http status code, OK = 200 if connected
+ */
+resultCode_t sckt_fetchStatus(scktCtrl_t *scktCtrl);
+
+
 /**
  *	@brief Send data to an established endpoint via protocol used to open socket (TCP/UDP/TCP INCOMING)
  
@@ -182,16 +432,118 @@ resultCode_t sckt_send(scktCtrl_t *scktCtrl, const char *data, uint16_t dataSz);
 
 
 /**
- *	@brief Fetch receive data by host application
+ *	@brief Send a datagram to a remote peer from a UDP service socket (sckt_setService)
+ 
+ *	@param scktCtrl [in] - Pointer to socket control struct governing the sending socket's operation
+ *	@param remoteIp [in] - IP address of the peer
+ *	@param remotePort [in] - Port of the peer
+ *	@param data [in] - A character pointer containing the data to send
+ *  @param dataSz [in] - The size of the buffer (< 1501 bytes)
+ *  @return Result code similar to http status code, OK = 200
+ */
+resultCode_t sckt_sendTo(scktCtrl_t *scktCtrl, const char *remoteIp, uint16_t remotePort, const char *data, uint16_t dataSz);
+
+
+/**
+ *	@brief Set an application supplied receive buffer, placing socket in pull-mode.
+ *  @details The driver retrieves data from the BGx into this ring buffer in the background (ltem_eventMgr), as space allows. 
+ *           The application reads at its own pace with sckt_fetchRecv()/sckt_peek(). Must be set before sckt_open().
+ 
+ *	@param scktCtrl [in] - Pointer to socket control being operated on.
+ *	@param recvBffr [in] - A char pointer to the application buffer to host the ring buffer, NULL returns socket to push-mode.
+ *  @param recvBffrSz [in] - The size of the buffer
+ */
+void sckt_setRecvBuffer(scktCtrl_t *scktCtrl, char *recvBffr, uint16_t recvBffrSz);
+
+
+/**
+ *	@brief Get the number of received chars available to the application in the socket receive buffer (pull-mode).
+ 
+ *	@param scktCtrl [in] - Pointer to socket control being operated on.
+ *  @return Number of chars available to fetch.
+ */
+uint16_t sckt_available(scktCtrl_t *scktCtrl);
+
+
+/**
+ *	@brief Enable (or disable) send coalescing; small writes are combined and sent together on size or age threshold.
+ *  @details Pending writes are sent when flushSz is reached, when flushAgeMs elapses (serviced by ltem_eventMgr()), on 
+ *           sckt_flushTx() or on sckt_close(). 
+ *	@param scktCtrl [in] - Pointer to socket control being operated on.
+ *	@param coalesceBffr [in] - Application buffer to hold pending writes, NULL disables coalescing.
+ *  @param bffrSz [in] - Size of coalesceBffr, must be at least flushSz.
+ *  @param flushSz [in] - Size threshold to trigger a send (max sckt__sendMaxSz).
+ *  @param flushAgeMs [in] - Max time a pending write is held before send.
+ */
+void sckt_enableCoalescing(scktCtrl_t *scktCtrl, char *coalesceBffr, uint16_t bffrSz, uint16_t flushSz, uint32_t flushAgeMs);
+
+
+/**
+ *	@brief Write data to socket; coalesced with other writes if enabled, otherwise sent immediately (sckt_send).
+ *	@param scktCtrl [in] - Pointer to socket control struct governing the sending socket's operation
+ *	@param data [in] - A character pointer containing the data to send
+ *  @param dataSz [in] - The size of the data
+ *  @return Result code similar to http status code, OK = 200; result of any send performed
+ */
+resultCode_t sckt_write(scktCtrl_t *scktCtrl, const char *data, uint16_t dataSz);
+
+
+/**
+ *	@brief Send any pending coalesced writes.
+ *	@param scktCtrl [in] - Pointer to socket control struct governing the sending socket's operation
+ *  @return Result code similar to http status code, OK = 200
+ */
+resultCode_t sckt_flushTx(scktCtrl_t *scktCtrl);
+
+
+/**
+ *	@brief Send a buffer of any length, segmented into maximal QISEND/QSSLSEND chunks.
+ *	@param scktCtrl [in] - Pointer to socket control struct governing the sending socket's operation
+ *	@param data [in] - A character pointer containing the data to send
+ *  @param dataSz [in] - The size of the data
+ *  @param sendResult [out] - Optional (can be NULL) send statistics: bytes, chunks, duration and throughput
+ *  @return Result code similar to http status code, OK = 200
+ */
+resultCode_t sckt_sendLarge(scktCtrl_t *scktCtrl, const char *data, uint32_t dataSz, scktSendResult_t *sendResult);
+
+
+/**
+ *	@brief Send data produced by an application callback, segmented into maximal QISEND/QSSLSEND chunks.
+ *  @details The work buffer is split into two halves; the producer fills the next half while the BGx accepts the current 
+ *           half, overlapping data preparation with the SEND OK wait.
+ *	@param scktCtrl [in] - Pointer to socket control struct governing the sending socket's operation
+ *	@param producer [in] - Application function supplying send data chunks, returns 0 at end of data
+ *	@param workBffr [in] - Application buffer for chunks, up to 2 * sckt__sendMaxSz is used
+ *  @param workBffrSz [in] - The size of the work buffer
+ *  @param sendResult [out] - Optional (can be NULL) send statistics: bytes, chunks, duration and throughput
+ *  @return Result code similar to http status code, OK = 200
+ */
+resultCode_t sckt_sendFromProducer(scktCtrl_t *scktCtrl, scktSendProducer_func producer, char *workBffr, uint16_t workBffrSz, scktSendResult_t *sendResult);
+
+
+/**
+ *	@brief Fetch receive data by host application (pull-mode).
  
  *	@param scktCtrl [in] - Pointer to socket control being operated on.
  *	@param recvBffr [in] - A char pointer to the data buffer for received chars
- *  @param dataSz [in] - The size of the buffer or request
- *  @return Number of chars outstanding in receive flow. This number can increase, if new data received while processing.
+ *  @param bffrSz [in] - The size of the buffer or request
+ *  @return Number of chars copied to recvBffr. 
  */
 uint16_t sckt_fetchRecv(scktCtrl_t *scktCtrl, char *recvBffr, uint16_t bffrSz);
 
 
+/**
+ *	@brief Peek at receive data in place, without removing it from the socket receive buffer (pull-mode).
+ *  @details Returns the contiguous block at the head of the receive buffer, which may be less than sckt_available() if 
+ *           the ring buffer content wraps. Use sckt_fetchRecv() to consume.
+ 
+ *	@param scktCtrl [in] - Pointer to socket control being operated on.
+ *	@param peekPtr [out] - Pointer set to the first received char.
+ *  @return Number of contiguous chars available at peekPtr.
+ */
+uint16_t sckt_peek(scktCtrl_t *scktCtrl, char **peekPtr);
+
+
 
 /**
  *	@brief Cancel an active receive flow and discard any recieved bytes.
@@ -0,0 +1,275 @@
+/** ****************************************************************************
+  \file 
+  \brief Socket connection pool: reuse of open TCP/UDP/SSL connections
+  \author Greg Terrell, LooUQ Incorporated
+
+  \loouq
+
+--------------------------------------------------------------------------------
+
+    This project is released under the GPL-3.0 License.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ 
+***************************************************************************** */
+
+
+#define _DEBUG 0                        // set to non-zero value for PRINTF debugging output, 
+// debugging output options             // LTEm1c will satisfy PRINTF references with empty definition if not already resolved
+#if _DEBUG > 0
+    asm(".global _printf_float");       // forces build to link in float support for printf
+    #if _DEBUG == 1
+    #define SERIAL_DBG 1                // enable serial port output using devl host platform serial, 1=wait for port
+    #elif _DEBUG == 2
+    #include <jlinkRtt.h>               // output debug PRINTF macros to J-Link RTT channel
+    #define PRINTF(c_,f_,__VA_ARGS__...) do { rtt_printf(c_, (f_), ## __VA_ARGS__); } while(0)
+    #endif
+#else
+#define PRINTF(c_, f_, ...)
+#endif
+
+#define SRCFILE "SPL"                           // create SRCFILE (3 char) MACRO for lq-diagnostics ASSERT
+#include "ltemc-internal.h"
+#include "ltemc-scktpool.h"
+
+extern ltemDevice_t g_lqLTEM;
+
+
+// file scope local function declarations
+static int8_t S__poolFindEntry(scktPool_t *pool, scktCtrl_t *scktCtrl);
+static int8_t S__poolFindIdle(scktPool_t *pool, streamType_t protocol, const char *hostUrl, uint16_t hostPort);
+static int8_t S__poolFindFree(scktPool_t *pool);
+static void S__poolEvict(scktPool_t *pool, uint8_t entryIndx);
+
+
+
+#pragma region public socket pool functions
+/* --------------------------------------------------------------------------------------------- */
+
+
+/**
+ *	@brief Initialize a socket connection pool over application supplied socket controls.
+ */
+void scktPool_init(scktPool_t *pool, scktCtrl_t *scktCtrls, uint8_t scktCnt, dataCntxt_t firstCntxt, uint32_t idleTimeoutMs)
+{
+    ASSERT(scktCnt <= scktPool__maxSz && firstCntxt + scktCnt <= dataCntxt__cnt);
+
+    uint8_t streamsFree = 0;
+    for (size_t i = 0; i < ltem__streamCnt; i++)
+    {
+        streamsFree += g_lqLTEM.streams[i] == NULL;
+    }
+    ASSERT(scktCnt <= streamsFree);                                             // open pool sockets must register in LTEm streams table
+
+    memset(pool, 0, sizeof(scktPool_t));
+    pool->entryCnt = scktCnt;
+    pool->idleTimeoutMs = idleTimeoutMs;
+    pool->healthCheck = true;
+
+    for (uint8_t i = 0; i < scktCnt; i++)
+    {
+        sckt_initControl(&scktCtrls[i], firstCntxt + i, streamType_TCP, NULL);    // protocol and callback set at checkout
+        pool->entries[i].scktCtrl = &scktCtrls[i];
+    }
+}
+
+
+/**
+ *	@brief Configure BGx TCP keepalive (AT+QICFG="tcp/keepalive"), applies to connections opened after this call.
+ */
+resultCode_t scktPool_setKeepalive(bool enable, uint8_t idleMin, uint8_t intervalSec, uint8_t probeCnt)
+{
+    bool invoked = enable ? atcmd_tryInvoke("AT+QICFG=\"tcp/keepalive\",1,%d,%d,%d", idleMin, intervalSec, probeCnt) :
+                            atcmd_tryInvoke("AT+QICFG=\"tcp/keepalive\",0");
+    if (!invoked)
+        return resultCode__conflict;
+    return atcmd_awaitResult();
+}
+
+
+/**
+ *	@brief Get a connection to protocol:host:port; an idle open connection is reused, otherwise a new connection is opened.
+ */
+scktCtrl_t* scktPool_checkout(scktPool_t *pool, streamType_t protocol, const char *hostUrl, uint16_t hostPort, scktAppRecv_func recvCallback, resultCode_t *rslt)
+{
+    int8_t entryIndx;
+    while ((entryIndx = S__poolFindIdle(pool, protocol, hostUrl, hostPort)) >= 0)  // reuse open connection
+    {
+        scktCtrl_t *scktCtrl = pool->entries[entryIndx].scktCtrl;
+        if (scktCtrl->state == scktState_open && (!pool->healthCheck || sckt_fetchStatus(scktCtrl) == resultCode__success))
+        {
+            if (scktCtrl->dataPending)                                              // unread data from prior use
+            {
+                sckt_flush(scktCtrl);
+            }
+            scktCtrl->appRecvDataCB = recvCallback;
+            pool->entries[entryIndx].checkedOut = true;
+            pool->statsHits++;
+            *rslt = resultCode__success;
+            return scktCtrl;
+        }
+        S__poolEvict(pool, entryIndx);                                              // closed by remote (+QIURC: "closed") or failed health check
+    }
+
+    pool->statsMisses++;
+    entryIndx = S__poolFindFree(pool);
+    if (entryIndx < 0)
+    {
+        *rslt = resultCode__conflict;                                               // all connections checked out
+        return NULL;
+    }
+    if (pool->entries[entryIndx].isOpen)                                            // replace LRU idle connection
+    {
+        S__poolEvict(pool, entryIndx);
+    }
+
+    scktCtrl_t *scktCtrl = pool->entries[entryIndx].scktCtrl;
+    sckt_initControl(scktCtrl, scktCtrl->dataCntxt, protocol, recvCallback);
+    sckt_setConnection(scktCtrl, 0, hostUrl, hostPort, 0);
+    *rslt = sckt_open(scktCtrl, true);
+    if (*rslt != resultCode__success)
+    {
+        pool->statsOpenFails++;
+        return NULL;
+    }
+    pool->entries[entryIndx].isOpen = true;
+    pool->entries[entryIndx].checkedOut = true;
+    return scktCtrl;
+}
+
+
+/**
+ *	@brief Return a connection to the pool.
+ */
+void scktPool_checkin(scktPool_t *pool, scktCtrl_t *scktCtrl, bool keepOpen)
+{
+    int8_t entryIndx = S__poolFindEntry(pool, scktCtrl);
+    ASSERT(entryIndx >= 0);
+
+    pool->entries[entryIndx].checkedOut = false;
+    pool->entries[entryIndx].lastUsedAt = pMillis();
+    scktCtrl->appRecvDataCB = NULL;                                                 // idle data is held (flushed at next checkout)
+
+    if (!keepOpen || scktCtrl->state != scktState_open)
+    {
+        S__poolEvict(pool, entryIndx);
+    }
+}
+
+
+/**
+ *	@brief Close idle connections closed by remote or past the idle timeout.
+ */
+void scktPool_evictIdle(scktPool_t *pool)
+{
+    for (uint8_t i = 0; i < pool->entryCnt; i++)
+    {
+        scktPoolEntry_t *entry = &pool->entries[i];
+        if (!entry->isOpen || entry->checkedOut)
+            continue;
+
+        if (entry->scktCtrl->state != scktState_open || (pool->idleTimeoutMs > 0 && pElapsed(entry->lastUsedAt, pool->idleTimeoutMs)))
+        {
+            S__poolEvict(pool, i);
+        }
+    }
+}
+
+
+/**
+ *	@brief Close all pool connections not checked out.
+ */
+void scktPool_closeAll(scktPool_t *pool)
+{
+    for (uint8_t i = 0; i < pool->entryCnt; i++)
+    {
+        if (pool->entries[i].isOpen && !pool->entries[i].checkedOut)
+        {
+            S__poolEvict(pool, i);
+        }
+    }
+}
+
+
+#pragma endregion
+
+
+#pragma region private local static functions
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ *   @brief Find pool entry for a socket control.
+ */
+static int8_t S__poolFindEntry(scktPool_t *pool, scktCtrl_t *scktCtrl)
+{
+    for (uint8_t i = 0; i < pool->entryCnt; i++)
+    {
+        if (pool->entries[i].scktCtrl == scktCtrl)
+            return i;
+    }
+    return -1;
+}
+
+
+/**
+ *   @brief Find an open, not checked out, connection to protocol:host:port.
+ */
+static int8_t S__poolFindIdle(scktPool_t *pool, streamType_t protocol, const char *hostUrl, uint16_t hostPort)
+{
+    for (uint8_t i = 0; i < pool->entryCnt; i++)
+    {
+        scktPoolEntry_t *entry = &pool->entries[i];
+        if (entry->isOpen && !entry->checkedOut && 
+            entry->scktCtrl->streamType == (char)protocol && 
+            entry->scktCtrl->hostPort == hostPort && 
+            strcmp(entry->scktCtrl->hostUrl, hostUrl) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+/**
+ *   @brief Find an entry for a new connection: closed entry, otherwise least recently used idle connection.
+ */
+static int8_t S__poolFindFree(scktPool_t *pool)
+{
+    int8_t lruIndx = -1;
+    for (uint8_t i = 0; i < pool->entryCnt; i++)
+    {
+        scktPoolEntry_t *entry = &pool->entries[i];
+        if (!entry->isOpen)
+            return i;
+        if (!entry->checkedOut && (lruIndx < 0 || (int32_t)(entry->lastUsedAt - pool->entries[lruIndx].lastUsedAt) < 0))
+            lruIndx = i;
+    }
+    return lruIndx;
+}
+
+
+/**
+ *   @brief Close pool connection and release BGx data context.
+ */
+static void S__poolEvict(scktPool_t *pool, uint8_t entryIndx)
+{
+    sckt_close(pool->entries[entryIndx].scktCtrl);
+    pool->entries[entryIndx].isOpen = false;
+    pool->entries[entryIndx].checkedOut = false;
+    pool->statsEvictions++;
+}
+
+
+#pragma endregion
@@ -0,0 +1,146 @@
+/** ****************************************************************************
+  \file 
+  \author Greg Terrell, LooUQ Incorporated
+
+  \loouq
+
+--------------------------------------------------------------------------------
+
+    This project is released under the GPL-3.0 License.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ 
+***************************************************************************** */
+
+
+
+
+#ifndef __LTEMC_SCKTPOOL_H__
+#define __LTEMC_SCKTPOOL_H__
+
+#include <lq-types.h>
+#include "ltemc-types.h"
+#include "ltemc-sckt.h"
+
+
+/** 
+ *  @brief Typed numeric constants for the socket connection pool
+ */
+enum scktPool__constants
+{
+    scktPool__maxSz = ltem__streamCnt,          /// pool sockets are registered in the LTEm streams table when open
+    scktPool__defaultIdleTimeoutMs = 120000     /// idle (checked in) connection is closed after this period
+};
+
+
+/** 
+ *  @brief Socket connection pool entry.
+*/
+typedef struct scktPoolEntry_tag
+{
+    scktCtrl_t *scktCtrl;                       /// application supplied socket control, hosts BGx data context
+    bool isOpen;                                /// connection is open and owned by pool
+    bool checkedOut;                            /// connection is in use by application
+    uint32_t lastUsedAt;                        /// tick count of last checkin, for idle timeout and replacement
+} scktPoolEntry_t;
+
+
+/** 
+ *  @brief Socket connection pool; reuses open connections keyed by protocol:host:port.
+*/
+typedef struct scktPool_tag
+{
+    scktPoolEntry_t entries[scktPool__maxSz];
+    uint8_t entryCnt;
+    uint32_t idleTimeoutMs;                     /// idle connections older than this are closed, 0 = no idle timeout
+    bool healthCheck;                           /// query BGx connection state (QISTATE/QSSLSTATE) before reusing an idle connection
+    uint32_t statsHits;                         /// checkouts served by an open connection (handshakes avoided)
+    uint32_t statsMisses;                       /// checkouts requiring a new connection (open/handshake)
+    uint32_t statsEvictions;                    /// connections closed: remote close, failed health check, idle timeout or replacement
+    uint32_t statsOpenFails;                    /// new connection open failures
+} scktPool_t;
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+
+/**
+ *	@brief Initialize a socket connection pool over application supplied socket controls.
+ *  @details Socket controls are assigned data contexts firstCntxt through firstCntxt + scktCnt - 1. For TLS connections the 
+ *           application configures TLS (tls_configure) for these data contexts before checkout.
+ *  @param pool [out] Pointer to pool structure
+ *  @param scktCtrls [in] Array of socket controls for pool use
+ *  @param scktCnt [in] Number of socket controls in array (max scktPool__maxSz and free LTEm stream slots)
+ *  @param firstCntxt [in] Data context of first pool socket
+ *  @param idleTimeoutMs [in] Idle connections are closed after this period, 0 = no idle timeout
+ */
+void scktPool_init(scktPool_t *pool, scktCtrl_t *scktCtrls, uint8_t scktCnt, dataCntxt_t firstCntxt, uint32_t idleTimeoutMs);
+
+
+/**
+ *	@brief Configure BGx TCP keepalive (AT+QICFG="tcp/keepalive"), applies to connections opened after this call.
+ *  @details Keepalive maintains NAT/firewall mappings and detects dead peers for idle pooled connections.
+ *  @param enable [in] Enable/disable keepalive
+ *  @param idleMin [in] Idle time (minutes) before first probe, 1-120
+ *  @param intervalSec [in] Interval (seconds) between probes, 25-100
+ *  @param probeCnt [in] Unanswered probes before connection is closed, 3-10
+ *  @return Result code similar to http status code, OK = 200
+ */
+resultCode_t scktPool_setKeepalive(bool enable, uint8_t idleMin, uint8_t intervalSec, uint8_t probeCnt);
+
+
+/**
+ *	@brief Get a connection to protocol:host:port; an idle open connection is reused, otherwise a new connection is opened.
+ *  @param pool [in] Pointer to pool structure
+ *  @param protocol [in] streamType_TCP, streamType_UDP or streamType_SSLTLS
+ *  @param hostUrl [in] Remote host name or IP address
+ *  @param hostPort [in] Remote port
+ *  @param recvCallback [in] Application receive callback for the connection while checked out
+ *  @param rslt [out] Result code similar to http status code, OK = 200; open result if new connection failed
+ *  @return Socket control for connection, NULL if no connection available
+ */
+scktCtrl_t* scktPool_checkout(scktPool_t *pool, streamType_t protocol, const char *hostUrl, uint16_t hostPort, scktAppRecv_func recvCallback, resultCode_t *rslt);
+
+
+/**
+ *	@brief Return a connection to the pool.
+ *  @param pool [in] Pointer to pool structure
+ *  @param scktCtrl [in] Socket control returned by scktPool_checkout()
+ *  @param keepOpen [in] True to keep connection for reuse, false to close (protocol error, etc.)
+ */
+void scktPool_checkin(scktPool_t *pool, scktCtrl_t *scktCtrl, bool keepOpen);
+
+
+/**
+ *	@brief Close idle connections closed by remote or past the idle timeout. Call periodically from application loop.
+ *  @param pool [in] Pointer to pool structure
+ */
+void scktPool_evictIdle(scktPool_t *pool);
+
+
+/**
+ *	@brief Close all pool connections not checked out.
+ *  @param pool [in] Pointer to pool structure
+ */
+void scktPool_closeAll(scktPool_t *pool);
+
+
+#ifdef __cplusplus
+}
+#endif // !__cplusplus
+
+#endif  /* !__LTEMC_SCKTPOOL_H__ */
@@ -51,6 +51,7 @@ enum ltem__constants
     ltem__moduleTypeSz = 8,
 
     ltem__streamCnt = 4,            /// 6 SSL/TLS capable data contexts + file system allowable, 4 concurrent seams reasonable
+    ltem__doWorkersCnt = 6,         /// max number of registered module background workers (sockets, dns, mqtt, mqtt batch, etc.)
     //ltem__urcHandlersCnt = 4        /// max number of concurrent protocol URC handlers (today only http, mqtt, sockets, filesystem)
 };
 
@@ -64,7 +65,8 @@ enum streams__constants
     streams__maxContextProtocols = 5,
     streams__typeCodeSz = 4,
     streams__urcPrefixesSz = 60,
-    host__urlSz = 100
+    host__urlSz = 100,
+    host__requestUrlSz = 240                    /// host + relative URL of a request (BGx holds one HTTP URL)
 };
 
 
@@ -117,6 +119,7 @@ typedef enum dataCntxt_tag
  * ------------------------------------------------------------------------------------------------------------------------------*/
 
 typedef void (*doWork_func)();                                           // module background worker
+typedef const char* (*dnsResolver_func)(const char *hostName);           // optional host name resolver (DNS cache), returns IP address or hostName
 typedef void (*powerSaveCallback_func)(uint8_t newPowerSaveState);
 
 
@@ -264,6 +264,9 @@ void S__initLTEmDevice(bool ltemReset)
         PRINTF(dbgColor__info, "LTEm ON (AppRdy)\r");
     }
 
+    g_lqLTEM.transparentMode = false;                       // BGx start/reset returns to command mode
+    if (g_lqLTEM.httpCfg != NULL)
+        g_lqLTEM.httpCfg->isValid = false;                  // BGx start/reset reverts HTTP settings to defaults
     IOP_attachIrq();                                        // attach I/O processor ISR to IRQ
     SC16IS7xx_enableIrqMode();                              // enable IRQ generation on SPI-UART bridge (IRQ mode)
     QBG_setOptions();                                       // initialize BGx operating settings
@@ -323,6 +326,19 @@ deviceState_t ltem_getDeviceState()
  */
 void ltem_eventMgr()
 {
+    if (g_lqLTEM.transparentMode)                                                   // RX is raw socket data, owned by application until exit
+        return;
+
+    /* service registered module background workers
+     */
+    for (size_t i = 0; i < ltem__doWorkersCnt; i++)
+    {
+        if (g_lqLTEM.doWorkers[i] != NULL)
+        {
+            (*g_lqLTEM.doWorkers[i])();
+        }
+    }
+
     /* look for a new incoming URC 
      */
     int16_t urcPossible = cbffr_find(g_lqLTEM.iop->rxBffr, "+", 0, 0, false);       // look for prefix char in URC
@@ -333,7 +349,7 @@ void ltem_eventMgr()
 
     for (size_t i = 0; i < ltem__streamCnt; i++)                                    // potential URC in rxBffr, see if a data handler will service
     {
-        resultCode_t serviceRslt;
+        resultCode_t serviceRslt = resultCode__cancelled;
         if (g_lqLTEM.streams[i] != NULL &&  g_lqLTEM.streams[i]->urcHndlr != NULL)  // URC event handler in this stream, offer the data to the handler
         {
             serviceRslt = g_lqLTEM.streams[i]->urcHndlr();
@@ -368,7 +384,7 @@ void ltem_deleteStream(streamCtrl_t *streamCtrl)
 {
     for (size_t i = 0; i < ltem__streamCnt; i++)
     {
-        if (g_lqLTEM.streams[i]->dataCntxt == streamCtrl->dataCntxt)
+        if (g_lqLTEM.streams[i] != NULL && g_lqLTEM.streams[i]->dataCntxt == streamCtrl->dataCntxt)
         {
             ASSERT(memcmp(g_lqLTEM.streams[i], streamCtrl, sizeof(streamCtrl_t)) == 0);     // compare the common fields
             g_lqLTEM.streams[i] = NULL;
@@ -382,7 +398,7 @@ streamCtrl_t* ltem_getStreamFromCntxt(uint8_t context, streamType_t streamType)
 {
     for (size_t i = 0; i < ltem__streamCnt; i++)
     {
-        if (g_lqLTEM.streams[i]->dataCntxt == context)
+        if (g_lqLTEM.streams[i] != NULL && g_lqLTEM.streams[i]->dataCntxt == context)
         {
             if (streamType == streamType__ANY)
             {
@@ -439,6 +455,29 @@ void ltem_setYieldCallback(platform_yieldCB_func_t yieldCallback)
 #pragma region LTEmC Internal Functions (ltemc-internal.h)
 /*-----------------------------------------------------------------------------------------------*/
 
+/**
+ *	@brief Register a module background worker, invoked on each pass of ltem_eventMgr().
+ */
+void LTEM_registerDoWorker(doWork_func doWorker)
+{
+    ASSERT(doWorker != NULL);
+
+    for (size_t i = 0; i < ltem__doWorkersCnt; i++)
+    {
+        if (g_lqLTEM.doWorkers[i] == doWorker)                                  // previously registered
+            return;
+    }
+    for (size_t i = 0; i < ltem__doWorkersCnt; i++)
+    {
+        if (g_lqLTEM.doWorkers[i] == NULL)
+        {
+            g_lqLTEM.doWorkers[i] = doWorker;
+            return;
+        }
+    }
+    ASSERT(false);                                                              // worker table full, increase ltem__doWorkersCnt
+}
+
 // void LTEM_registerUrcHandler(urcHandler_func *urcHandler)
 // {
 //     bool registered = false;
@@ -71,11 +71,17 @@
 #define SCKTTEST_PROTOCOL streamType_UDP
 #define SCKTTEST_HOST "71.13.234.38"    // put your test host information here 
 #define SCKTTEST_PORT 9011              // and here
+#define SCKTTEST_ACCESSMODE scktAccessMode_buffer   // scktAccessMode_directPush to compare receive latency/throughput (server echo)
 
 
 uint16_t loopCnt = 0;
 uint32_t lastCycle;
 
+uint32_t sendAt;                                // echo latency/throughput benchmark
+uint32_t latencyTotal;
+uint32_t latencyCnt;
+uint32_t rxBytes;
+
 static scktCtrl_t scktCtrl;                     // handle for socket operations
 static uint8_t receiveBuffer[SCKTTEST_RXBUFSZ]; // appl creates a rxBuffer for protocols, sized to your expected flows (will be incorporated into scktCtrl)
 
@@ -107,6 +113,7 @@ void setup() {
     // create a socket control and open it
     sckt_initControl(&scktCtrl, dataCntxt_0, SCKTTEST_PROTOCOL, scktRecvCB);
     sckt_setConnection(&scktCtrl, PDP_DATA_CONTEXT, SCKTTEST_HOST, SCKTTEST_PORT, 0);
+    sckt_setAccessMode(&scktCtrl, SCKTTEST_ACCESSMODE);
     resultCode_t scktResult = sckt_open(&scktCtrl,  true);
 
     if (scktResult == resultCode__previouslyOpened)
@@ -149,6 +156,7 @@ void loop()
         sendBffr[25] = 0;                                                   // test for data transparency, embedded NULL
         #endif
 
+        sendAt = pMillis();
         resultCode_t sendResult = sckt_send(&scktCtrl, sendBffr, sendSz);
         PRINTF(dbgColor__info, "Send result=%d\r", sendResult);
         
@@ -177,6 +185,14 @@ uint16_t scktRecover()
 */
 void scktRecvCB(dataCntxt_t dataCntxt, char* dataPtr, uint16_t dataSz, bool isFinal)
 {
+    rxBytes += dataSz;
+    if (isFinal && sendAt > 0)
+    {
+        latencyTotal += pMillis() - sendAt;                                 // send to echo delivered (final block)
+        latencyCnt++;
+        sendAt = 0;
+    }
+
     // char temp[dataSz + 1];
 
     // sckt_fetchRecv(&scktCtrl, temp, sizeof(temp));
@@ -215,6 +231,11 @@ void showStats()
 
     PRINTF(dbgColor__magenta, "\rTX=%d, RX=%d \r", scktCtrl.statsRxCnt, scktCtrl.statsRxCnt);
     PRINTF(dbgColor__magenta, "FreeMem=%u  Loop=%d\r", getFreeMemory(), loopCnt);
+    if (latencyCnt > 0)
+    {
+        PRINTF(dbgColor__magenta, "AccessMode=%d  AvgEchoLatency=%lums  RxBytes=%lu (%lu B/s)\r", 
+               SCKTTEST_ACCESSMODE, latencyTotal / latencyCnt, rxBytes, rxBytes * 1000 / pMillis());
+    }
 
     // lastTx = txCnt;
     // lastRx = rxCnt;
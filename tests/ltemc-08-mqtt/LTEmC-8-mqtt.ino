@@ -117,6 +117,7 @@ uint32_t lastCycle;
 // LTEm variables
 mqttCtrl_t mqttCtrl;                // MQTT control, data to manage MQTT connection to server
 mqttTopicCtrl_t topicCtrl;
+mqttTopicNode_t topicNodes[8];      // subscription topic trie nodes, one per topic filter level
 
 char mqttTopic[200];                // application buffer to craft TX MQTT topic
 char mqttTopicProp[200];
@@ -158,6 +159,7 @@ void setup() {
     tls_configure(dataCntxt_0, tlsVersion_tls12, tlsCipher_default, tlsCertExpiration_default, tlsSecurityLevel_default);
 
     mqtt_initControl(&mqttCtrl, MQTT_DATACONTEXT);
+    mqtt_setTopicPool(&mqttCtrl, topicNodes, sizeof(topicNodes) / sizeof(mqttTopicNode_t));
     mqtt_initTopicControl(&topicCtrl, MQTT_IOTHUB_C2D_TOPIC, mqttQos_1, mqttRecvCB);
 
     mqtt_subscribeTopic(&mqttCtrl, &topicCtrl);
@@ -162,11 +162,13 @@ void loop()
         {
             // resultCode_t http_get(httpCtrl_t *httpCtrl, const char* url)   
             // default HTTP timeout is 60 seconds
+            uint32_t rqstStart = pMillis();
             rslt = http_get(&httpCtrlG, "/points/44.7582,-85.6022", http__noResponseHeaders);
             if (rslt == resultCode__success)
             {
                 httpCtrl = &httpCtrlG;
-                PRINTF(dbgColor__info, "GET invoked successfully\r");
+                uint32_t rqstDuration = pMillis() - rqstStart;                  // repeated GET to same URL skips BGx config/URL commands
+                PRINTF(dbgColor__info, "GET invoked successfully, %dms (%d rqsts/min)\r", rqstDuration, rqstDuration ? 60000 / rqstDuration : 0);
             }
             else
                 PRINTF(dbgColor__warn, "HTTP GET failed, status=%d\r", rslt);